@@ -0,0 +1,230 @@
+#ifndef JDECOMPILER_ARENA_CPP
+#define JDECOMPILER_ARENA_CPP
+
+#include <cstddef>
+
+namespace jdecompiler {
+
+	struct ArenaObject;
+
+	/* Owns the decompiled code of a single class: instructions, operations, scopes, blocks, variables and contexts.
+	   All objects are destroyed at once when the arena is released. An arena is used by one thread at a time */
+	struct Arena {
+		private:
+			static constexpr size_t CHUNK_SIZE = 64 * 1024, ALIGNMENT = alignof(std::max_align_t);
+
+			vector<pair<uint8_t*, uint8_t*>> chunks;
+			uint8_t *pos = nullptr, *end = nullptr;
+
+			vector<void*> objects;
+
+			/* Each object is preceded by a header, so delete finds the arena of the object and its slot without searching.
+			   Objects allocated on the heap have a header without an arena.
+			   The object is destroyed through its ArenaObject subobject, which is not always at the start of the object */
+			struct Header {
+				Arena* arena;
+				size_t index, size;
+				ArenaObject* object;
+			};
+
+			static constexpr size_t HEADER_SIZE = (sizeof(Header) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+			static inline Header* getHeader(void* ptr) {
+				return reinterpret_cast<Header*>(static_cast<uint8_t*>(ptr) - HEADER_SIZE);
+			}
+
+			static inline thread_local Arena* current = nullptr;
+
+		public:
+			Arena() noexcept {}
+
+			Arena(const Arena&) = delete;
+			Arena& operator=(const Arena&) = delete;
+
+			static inline Arena* getCurrent() {
+				return current;
+			}
+
+			void* allocate(size_t size) {
+				size = HEADER_SIZE + ((size + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+
+				if(size > static_cast<size_t>(end - pos)) {
+					const size_t chunkSize = max(size, CHUNK_SIZE);
+
+					pos = static_cast<uint8_t*>(::operator new(chunkSize));
+					end = pos + chunkSize;
+					chunks.emplace_back(pos, end);
+				}
+
+				void* ptr = pos + HEADER_SIZE;
+				pos += size;
+
+				Header* header = getHeader(ptr);
+				header->arena = this;
+				header->index = objects.size();
+				header->size = size - HEADER_SIZE;
+				header->object = nullptr;
+
+				objects.push_back(ptr);
+				return ptr;
+			}
+
+		private:
+			inline bool isInChunks(const uint8_t* address) const {
+				for(size_t i = chunks.size(); i-- > 0; )
+					if(address >= chunks[i].first && address < chunks[i].second)
+						return true;
+
+				return false;
+			}
+
+			/* Called from the constructor of ArenaObject. The object is usually the last one allocated, but the arguments
+			   of its constructor can be allocated after it. Objects which are not allocated in the arena are ignored */
+			void setObject(ArenaObject* object) noexcept {
+				const uint8_t* const address = reinterpret_cast<const uint8_t*>(object);
+
+				if(!isInChunks(address))
+					return;
+
+				for(size_t i = objects.size(); i-- > 0; ) {
+					const uint8_t* const ptr = static_cast<const uint8_t*>(objects[i]);
+
+					if(ptr != nullptr && address >= ptr && address < ptr + getHeader(objects[i])->size) {
+						/* An object can have several ArenaObject subobjects, the first constructed one is used */
+						Header* header = getHeader(objects[i]);
+
+						if(header->object == nullptr)
+							header->object = object;
+
+						return;
+					}
+				}
+			}
+
+			/* The memory is not reused, the object is only removed from the arena */
+			void deallocate(size_t index) {
+				if(index < objects.size())
+					objects[index] = nullptr;
+			}
+
+			friend struct ArenaObject;
+
+			/* Allocates the object in the current arena, if there is one, otherwise on the heap */
+			static void* allocateObject(size_t size) {
+				if(current != nullptr)
+					return current->allocate(size);
+
+				void* ptr = static_cast<uint8_t*>(::operator new(HEADER_SIZE + size)) + HEADER_SIZE;
+
+				Header* header = getHeader(ptr);
+				header->arena = nullptr;
+				header->index = 0;
+				header->size = size;
+				header->object = nullptr;
+
+				return ptr;
+			}
+
+			static void registerObject(ArenaObject* object) noexcept {
+				if(current != nullptr)
+					current->setObject(object);
+			}
+
+			/* Works regardless of the current arena */
+			static void freeObject(void* ptr) {
+				Header* header = getHeader(ptr);
+
+				if(header->arena != nullptr)
+					header->arena->deallocate(header->index);
+				else
+					::operator delete(header);
+			}
+
+		public:
+			/* Destroys all objects in the reverse order and frees the memory */
+			void release();
+
+			~Arena() {
+				release();
+			}
+
+
+			/* Makes the arena current for this thread while the guard exists */
+			struct Guard {
+				private:
+					Arena* const previous;
+
+				public:
+					explicit Guard(Arena& arena) noexcept: previous(current) {
+						current = &arena;
+					}
+
+					/* Objects are allocated on the heap while the guard exists */
+					explicit Guard(std::nullptr_t) noexcept: previous(current) {
+						current = nullptr;
+					}
+
+					Guard(const Guard&) = delete;
+					Guard& operator=(const Guard&) = delete;
+
+					~Guard() {
+						current = previous;
+					}
+			};
+	};
+
+
+	/* Objects of this type are allocated in the current arena, if there is one, otherwise on the heap.
+	   The arena destroys objects through the ArenaObject subobject, which registers itself when it is constructed */
+	struct ArenaObject {
+		protected:
+			ArenaObject() noexcept {
+				Arena::registerObject(this);
+			}
+
+			ArenaObject(const ArenaObject&) noexcept {
+				Arena::registerObject(this);
+			}
+
+		public:
+			virtual ~ArenaObject() {}
+
+			static void* operator new(size_t size) {
+				return Arena::allocateObject(size);
+			}
+
+			static void operator delete(void* ptr) {
+				Arena::freeObject(ptr);
+			}
+	};
+
+
+	inline void Arena::release() {
+		/* Destructors can delete other objects of this arena */
+		const Guard guard(*this);
+
+		for(size_t i = objects.size(); i-- > 0; ) {
+			void* ptr = objects[i];
+
+			if(ptr != nullptr) {
+				objects[i] = nullptr;
+
+				ArenaObject* object = getHeader(ptr)->object;
+
+				if(object != nullptr)
+					object->~ArenaObject();
+			}
+		}
+
+		for(const auto& chunk : chunks)
+			::operator delete(chunk.first);
+
+		objects.clear();
+		objects.shrink_to_fit();
+		chunks.clear();
+		chunks.shrink_to_fit();
+		pos = end = nullptr;
+	}
+}
+
+#endif
@@ -19,17 +19,34 @@ namespace jdecompiler {
 	};
 
 
+	/* Kinds of the known attributes. Each attribute class defines its kind as SLOT */
+	enum class AttributeSlot {
+		CONSTANT_VALUE, CODE, ANNOTATIONS, PARAMETER_ANNOTATIONS, ANNOTATION_DEFAULT, EXCEPTIONS, DEPRECATED,
+		LOCAL_VARIABLE_TABLE, SIGNATURE, BOOTSTRAP_METHODS, INNER_CLASSES, NEST_MEMBERS, SOURCE_FILE
+	};
+
+
 	struct Attributes: vector<const Attribute*> {
-		public:
+		private:
+			static constexpr size_t SLOTS_COUNT = static_cast<size_t>(AttributeSlot::SOURCE_FILE) + 1;
+
+			/* The first attribute of each kind, filled by readAttribute */
+			const Attribute* slots[SLOTS_COUNT] = {};
+
 			template<class T>
-			const T* get() const {
-				for(const Attribute* attribute : *this) {
-					if(instanceof<const T*>(attribute)) {
-						return static_cast<const T*>(attribute);
-					}
-				}
+			inline const T* fillSlot(const T* attribute) {
+				const Attribute*& slot = slots[static_cast<size_t>(T::SLOT)];
+
+				if(slot == nullptr)
+					slot = attribute;
+
+				return attribute;
+			}
 
-				return nullptr;
+		public:
+			template<class T>
+			inline const T* get() const {
+				return static_cast<const T*>(slots[static_cast<size_t>(T::SLOT)]);
 			}
 
 			template<class T>
@@ -44,9 +61,10 @@ namespace jdecompiler {
 				return get<T>() != nullptr;
 			}
 
-			static const Attribute* readAttribute(ClassInputStream&, const ConstantPool&, const string&, uint32_t, AttributesType);
+			const Attribute* readAttribute(ClassInputStream&, const ConstantPool&, const string&, uint32_t, AttributesType);
 
 			Attributes(ClassInputStream& instream, const ConstantPool& constPool, uint16_t attributeCount, AttributesType attributesType) {
+				const Stats::Timer timer(Stats::Phase::ATTRIBUTES);
 
 				this->reserve(attributeCount);
 
@@ -56,7 +74,7 @@ namespace jdecompiler {
 					const string& name = constPool.getUtf8Constant(addr);
 
 					const uint32_t length = instream.readUInt();
-					const streampos pos = instream.getPos() + (streampos)length;
+					const size_t pos = instream.getPos() + length;
 
 					const Attribute* attribute = readAttribute(instream, constPool, name, length, attributesType);
 
@@ -82,17 +100,22 @@ namespace jdecompiler {
 	};
 
 
+	/* The stream is deleted after the class is read, so the bytes which are kept by the class are copied */
+	static inline const uint8_t* copyBytes(ClassInputStream& instream, uint32_t length) {
+		uint8_t* bytes = new uint8_t[length];
+		memcpy(bytes, instream.readBytes(length), length);
+		return bytes;
+	}
+
 	struct UnknownAttribute: Attribute {
 		const uint8_t* const bytes;
 		UnknownAttribute(const string& name, uint32_t length, ClassInputStream& instream):
-				Attribute(name, length), bytes(instream.readBytes(length)) {}
-
-		virtual ~UnknownAttribute() override {
-			delete bytes;
-		}
+				Attribute(name, length), bytes(copyBytes(instream, length)) {}
 	};
 
 	struct ConstantValueAttribute: Attribute/*, Stringified*/ {
+		static constexpr AttributeSlot SLOT = AttributeSlot::CONSTANT_VALUE;
+
 		const ConstValueConstant* const value;
 
 		ConstantValueAttribute(uint32_t length, ClassInputStream& instream, const ConstantPool& constPool):
@@ -112,6 +135,8 @@ namespace jdecompiler {
 	};
 
 	struct CodeAttribute: Attribute {
+		static constexpr AttributeSlot SLOT = AttributeSlot::CODE;
+
 		struct ExceptionHandler final {
 			public:
 				const uint16_t startPos, endPos, handlerPos;
@@ -119,18 +144,13 @@ namespace jdecompiler {
 
 			protected:
 				static inline const ClassType* getCatchType(const ClassConstant* classConstant) {
-					return classConstant == nullptr ? nullptr : new ClassType(classConstant);
+					return classConstant == nullptr ? nullptr : ClassType::getInstance(classConstant);
 				}
 
 			public:
 				ExceptionHandler(ClassInputStream& instream, const ConstantPool& constPool):
 						startPos(instream.readUShort()), endPos(instream.readUShort()), handlerPos(instream.readUShort()),
 						catchType(getCatchType(constPool.getNullable<ClassConstant>(instream.readUShort()))) {}
-
-				~ExceptionHandler() {
-					if(catchType != nullptr)
-						delete catchType;
-				}
 		};
 
 		static const vector<const ExceptionHandler*> readExceptionTable(ClassInputStream& instream, const ConstantPool& constPool) {
@@ -153,7 +173,7 @@ namespace jdecompiler {
 
 		CodeAttribute(uint32_t length, ClassInputStream& instream, const ConstantPool& constPool):
 				Attribute("Code", length), maxStack(instream.readUShort()), maxLocals(instream.readUShort()),
-				codeLength(instream.readUInt()), code(instream.readBytes(codeLength)),
+				codeLength(instream.readUInt()), code(copyBytes(instream, codeLength)),
 				exceptionTable(readExceptionTable(instream, constPool)),
 				attributes(*new Attributes(instream, constPool, instream.readUShort(), AttributesType::ATTRIBUTE)) {}
 	};
@@ -310,6 +330,8 @@ namespace jdecompiler {
 
 
 	struct AnnotationsAttribute: Attribute, Stringified {
+		static constexpr AttributeSlot SLOT = AttributeSlot::ANNOTATIONS;
+
 		vector<const Annotation*> annotations;
 
 		AnnotationsAttribute(const string& name, uint32_t length, ClassInputStream& instream, const ConstantPool& constPool):
@@ -328,6 +350,8 @@ namespace jdecompiler {
 
 
 	struct ParameterAnnotationsAttribute: Attribute {
+		static constexpr AttributeSlot SLOT = AttributeSlot::PARAMETER_ANNOTATIONS;
+
 		vector<vector<const Annotation*>> parameterAnnotations;
 
 		ParameterAnnotationsAttribute(const string& name, uint32_t length, ClassInputStream& instream, const ConstantPool& constPool):
@@ -379,6 +403,8 @@ namespace jdecompiler {
 
 
 	struct AnnotationDefaultAttribute: Attribute, Stringified {
+		static constexpr AttributeSlot SLOT = AttributeSlot::ANNOTATION_DEFAULT;
+
 		const AnnotationValue& value;
 
 		AnnotationDefaultAttribute(uint32_t length, ClassInputStream& instream, const ConstantPool& constPool):
@@ -398,6 +424,8 @@ namespace jdecompiler {
 
 
 	struct ExceptionsAttribute: Attribute {
+		static constexpr AttributeSlot SLOT = AttributeSlot::EXCEPTIONS;
+
 		vector<const ClassConstant*> exceptions;
 
 		ExceptionsAttribute(uint32_t length, ClassInputStream& instream, const ConstantPool& constPool): Attribute("Exceptions", length) {
@@ -408,6 +436,8 @@ namespace jdecompiler {
 
 
 	struct DeprecatedAttribute: Attribute {
+		static constexpr AttributeSlot SLOT = AttributeSlot::DEPRECATED;
+
 		DeprecatedAttribute(uint32_t length): Attribute("Deprecated", length) {
 			if(length != 0) throw IllegalAttributeException("Length of Deprecated attribute must be 0");
 		}
@@ -416,6 +446,8 @@ namespace jdecompiler {
 
 
 	struct LocalVariableTableAttribute: Attribute {
+		static constexpr AttributeSlot SLOT = AttributeSlot::LOCAL_VARIABLE_TABLE;
+
 		struct LocalVariable {
 			const uint16_t startPos, endPos;
 			const string& name;
@@ -472,7 +504,7 @@ namespace jdecompiler {
 			while(*str != '\0') {
 				if(str[0] != 'L')
 					throw InvalidSignatureException(srcStr, str - srcStr);
-				interfaces.push_back(new ClassType(str += 1));
+				interfaces.push_back(ClassType::getInstance(str += 1));
 			}
 		}
 	};
@@ -495,6 +527,7 @@ namespace jdecompiler {
 
 	template<class Signature>
 	struct SignatureAttribute: Attribute {
+		static constexpr AttributeSlot SLOT = AttributeSlot::SIGNATURE;
 
 		const Signature& signature;
 
@@ -533,6 +566,8 @@ namespace jdecompiler {
 
 
 	struct BootstrapMethodsAttribute: Attribute {
+		static constexpr AttributeSlot SLOT = AttributeSlot::BOOTSTRAP_METHODS;
+
 		protected:
 			vector<const BootstrapMethod*> bootstrapMethods;
 
@@ -563,6 +598,8 @@ namespace jdecompiler {
 
 
 	struct InnerClassesAttribute: Attribute {
+		static constexpr AttributeSlot SLOT = AttributeSlot::INNER_CLASSES;
+
 		vector<const InnerClass*> classes;
 
 		InnerClassesAttribute(uint32_t length, ClassInputStream& instream, const ConstantPool& constPool):
@@ -584,6 +621,8 @@ namespace jdecompiler {
 
 
 	struct NestMembersAttribute: Attribute {
+		static constexpr AttributeSlot SLOT = AttributeSlot::NEST_MEMBERS;
+
 		vector<const ClassType*> nestMembers;
 
 		NestMembersAttribute(uint32_t length, ClassInputStream& instream, const ConstantPool& constPool):
@@ -593,12 +632,14 @@ namespace jdecompiler {
 			nestMembers.reserve(size);
 
 			for(uint16_t i = size; i > 0; i--)
-				nestMembers.push_back(new ClassType(constPool.get<ClassConstant>(instream.readUShort())));
+				nestMembers.push_back(ClassType::getInstance(constPool.get<ClassConstant>(instream.readUShort())));
 		}
 	};
 
 
 	struct SourceFileAttribute: Attribute {
+		static constexpr AttributeSlot SLOT = AttributeSlot::SOURCE_FILE;
+
 		const string& sourceFile;
 
 		SourceFileAttribute(uint32_t length, ClassInputStream& instream, const ConstantPool& constPool):
@@ -614,16 +655,16 @@ namespace jdecompiler {
 			const string& name, uint32_t length, AttributesType attributesType) {
 
 		if(attributesType != AttributesType::ATTRIBUTE) {
-			if(name == "Deprecated") return new DeprecatedAttribute(length);
+			if(name == "Deprecated") return fillSlot(new DeprecatedAttribute(length));
 			if(name == "RuntimeVisibleAnnotations" || name == "RuntimeInvisibleAnnotations")
-				return new AnnotationsAttribute(name, length, instream, constPool);
+				return fillSlot(new AnnotationsAttribute(name, length, instream, constPool));
 			if(name == "RuntimeVisibleParameterAnnotations" || name == "RuntimeInvisibleParameterAnnotations")
-				return new ParameterAnnotationsAttribute(name, length, instream, constPool);
+				return fillSlot(new ParameterAnnotationsAttribute(name, length, instream, constPool));
 			if(name == "Signature") {
 				switch(attributesType) {
-					case AttributesType::CLASS:  return new  ClassSignatureAttribute(length, instream, constPool);
-					case AttributesType::FIELD:  return new  FieldSignatureAttribute(length, instream, constPool);
-					case AttributesType::METHOD: return new MethodSignatureAttribute(length, instream, constPool);
+					case AttributesType::CLASS:  return fillSlot(new  ClassSignatureAttribute(length, instream, constPool));
+					case AttributesType::FIELD:  return fillSlot(new  FieldSignatureAttribute(length, instream, constPool));
+					case AttributesType::METHOD: return fillSlot(new MethodSignatureAttribute(length, instream, constPool));
 					default: throw Exception("Seriously?");
 				}
 			}
@@ -631,24 +672,24 @@ namespace jdecompiler {
 
 		switch(attributesType) {
 			case AttributesType::CLASS:
-				if(name == "BootstrapMethods") return new BootstrapMethodsAttribute(length, instream, constPool);
-				if(name == "InnerClasses") return new InnerClassesAttribute(length, instream, constPool);
-				if(name == "NestMembers") return new NestMembersAttribute(length, instream, constPool);
-				if(name == "SourceFile") return new SourceFileAttribute(length, instream, constPool);
+				if(name == "BootstrapMethods") return fillSlot(new BootstrapMethodsAttribute(length, instream, constPool));
+				if(name == "InnerClasses") return fillSlot(new InnerClassesAttribute(length, instream, constPool));
+				if(name == "NestMembers") return fillSlot(new NestMembersAttribute(length, instream, constPool));
+				if(name == "SourceFile") return fillSlot(new SourceFileAttribute(length, instream, constPool));
 				break;
 
 			case AttributesType::FIELD:
-				if(name == "ConstantValue") return new ConstantValueAttribute(length, instream, constPool);
+				if(name == "ConstantValue") return fillSlot(new ConstantValueAttribute(length, instream, constPool));
 				break;
 
 			case AttributesType::METHOD:
-				if(name == "Code") return new CodeAttribute(length, instream, constPool);
-				if(name == "Exceptions") return new ExceptionsAttribute(length, instream, constPool);
-				if(name == "AnnotationDefault") return new AnnotationDefaultAttribute(length, instream, constPool);
+				if(name == "Code") return fillSlot(new CodeAttribute(length, instream, constPool));
+				if(name == "Exceptions") return fillSlot(new ExceptionsAttribute(length, instream, constPool));
+				if(name == "AnnotationDefault") return fillSlot(new AnnotationDefaultAttribute(length, instream, constPool));
 				break;
 
 			case AttributesType::ATTRIBUTE:
-				if(name == "LocalVariableTable") return new LocalVariableTableAttribute(length, instream, constPool);
+				if(name == "LocalVariableTable") return fillSlot(new LocalVariableTableAttribute(length, instream, constPool));
 		}
 
 		return new UnknownAttribute(name, length, instream);
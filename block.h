@@ -3,7 +3,7 @@
 
 namespace jdecompiler {
 
-	struct Block {
+	struct Block: ArenaObject {
 		public:
 			mutable index_t startIndex, endIndex;
 			mutable const Block* parentBlock;
@@ -6,7 +6,7 @@ namespace jdecompiler {
 	struct TryBlock: Block {
 		protected:
 			mutable vector<CatchBlock*> handlers;
-			friend const StringifyContext& Method::decompileCode(const ClassInfo&);
+			friend const StringifyContext& Method::decompileCode() const;
 			friend struct GotoInstruction;
 
 		public:
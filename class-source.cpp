@@ -0,0 +1,49 @@
+#ifndef JDECOMPILER_CLASS_SOURCE_CPP
+#define JDECOMPILER_CLASS_SOURCE_CPP
+
+namespace jdecompiler {
+
+	/* The class file specified in the command line or the class entry of an archive.
+	   The entry is inflated only when the class is indexed or read. Each source is read at most once */
+	struct ClassSource {
+		private:
+			ClassInputStream* stream;
+			const ZipArchive* const archive;
+			const ZipArchive::Entry* const entry;
+
+			once_flag readFlag;
+			const Class* clazz = nullptr;
+
+			/* The position of the source in the order of the files */
+			size_t index = 0;
+
+			friend struct JDecompiler;
+
+		public:
+			const string fileName;
+
+			explicit ClassSource(ClassInputStream* stream):
+					stream(stream), archive(nullptr), entry(nullptr), fileName(stream->fileName) {}
+
+			explicit ClassSource(const ZipArchive* archive, const ZipArchive::Entry* entry, const string& fileName):
+					stream(nullptr), archive(archive), entry(entry), fileName(fileName) {}
+
+			ClassSource(const ClassSource&) = delete;
+			ClassSource& operator=(const ClassSource&) = delete;
+
+			inline ClassInputStream& open() {
+				if(stream == nullptr)
+					stream = archive->open(*entry, fileName);
+
+				return *stream;
+			}
+
+			/* Frees the data of the file or of the inflated entry. The source is not opened again after it is read */
+			inline void close() {
+				delete stream;
+				stream = nullptr;
+			}
+	};
+}
+
+#endif
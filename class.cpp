@@ -17,7 +17,7 @@ namespace jdecompiler {
 			try {
 				fields.push_back(fieldData.createField(classinfo));
 			} catch(DecompilationException& ex) {
-				cerr << "Exception while decompiling field " << fieldData.descriptor.toString() << ": " << ex.toString() << endl;
+				JDecompiler::getErrorStream() << "Exception while decompiling field " << fieldData.descriptor.toString() << ": " << ex.toString() << endl;
 			}
 		}
 
@@ -25,6 +25,46 @@ namespace jdecompiler {
 	}
 
 
+	Class::ConstantsIndex Class::indexConstants(const vector<const Field*>& constants) {
+		ConstantsIndex index;
+
+		for(const Field* field : constants) {
+			const ConstValueConstant* value = field->constantValueAttribute->value;
+
+			if(const IntegerConstant* intConstant = dynamic_cast<const IntegerConstant*>(value))
+				std::get<ConstantsByValue<jint>>(index)[intConstant->value].push_back(field);
+
+			else if(const LongConstant* longConstant = dynamic_cast<const LongConstant*>(value))
+				std::get<ConstantsByValue<jlong>>(index)[longConstant->value].push_back(field);
+
+			else if(const FloatConstant* floatConstant = dynamic_cast<const FloatConstant*>(value))
+				std::get<ConstantsByValue<jfloat>>(index)[floatConstant->value].push_back(field);
+
+			else if(const DoubleConstant* doubleConstant = dynamic_cast<const DoubleConstant*>(value))
+				std::get<ConstantsByValue<jdouble>>(index)[doubleConstant->value].push_back(field);
+
+			else if(const StringConstant* stringConstant = dynamic_cast<const StringConstant*>(value))
+				std::get<ConstantsByValue<string>>(index)[stringConstant->value].push_back(field);
+		}
+
+		return index;
+	}
+
+
+	string Class::descriptorKey(const FieldDescriptor& descriptor) {
+		return descriptor.name + ':' + descriptor.type.getEncodedName();
+	}
+
+	umap<string, vector<const Field*>> Class::indexFields(const vector<const Field*>& fields, string(*keyOf)(const FieldDescriptor&)) {
+		umap<string, vector<const Field*>> index;
+
+		for(const Field* field : fields)
+			index[keyOf(field->descriptor)].push_back(field);
+
+		return index;
+	}
+
+
 	const vector<const Method*> Class::createMethods(const vector<MethodDataHolder>& methodsData, const ClassInfo& classinfo) const {
 		vector<const Method*> methods;
 		methods.reserve(methodsData.size());
@@ -35,14 +75,30 @@ namespace jdecompiler {
 		return methods;
 	}
 
-	const StringifyContext& Class::getFieldStringifyContext() {
-		const MethodDescriptor& staticInitializerDescriptor = *new MethodDescriptor(thisType, "<clinit>", VOID);
+	string Class::descriptorKey(const MethodDescriptor& descriptor) {
+		string key = descriptor.name + '(';
+
+		for(const Type* argument : descriptor.arguments)
+			key += argument->getEncodedName();
+
+		return key + ')' + descriptor.returnType->getEncodedName();
+	}
+
+	umap<string, vector<const Method*>> Class::indexMethods(const vector<const Method*>& methods) {
+		umap<string, vector<const Method*>> index;
 
-		const Method* staticInitializer = getMethod(staticInitializerDescriptor);
+		for(const Method* method : methods)
+			index[descriptorKey(method->descriptor)].push_back(method);
 
-		return staticInitializer != nullptr ? staticInitializer->context :
+		return index;
+	}
+
+	const StringifyContext& Class::getFieldStringifyContext() {
+		const Method* staticInitializer = getMethod(MethodDescriptor(thisType, "<clinit>", VOID));
+
+		return staticInitializer != nullptr ? staticInitializer->getContext() :
 			*new StringifyContext(classinfo.getEmptyDisassemblerContext(), classinfo,
-					new MethodScope(0, 0, 0), ACC_STATIC, staticInitializerDescriptor, Attributes::getEmptyInstance());
+					new MethodScope(0, 0, 0), ACC_STATIC, *new MethodDescriptor(thisType, "<clinit>", VOID), Attributes::getEmptyInstance());
 	}
 
 
@@ -54,7 +110,11 @@ namespace jdecompiler {
 			ClassElement(modifiers), version(version), thisType(thisType), superType(superType),
 			constPool(constPool), interfaces(interfaces), attributes(attributes),
 			classinfo(*new ClassInfo(*this, thisType, superType, interfaces, constPool, attributes, modifiers, version)),
-			fields(createFields(fieldsData, classinfo)), constants(filterConstants(fields)), methods(createMethods(methodsData, classinfo)),
+			fields(createFields(fieldsData, classinfo)), constants(filterConstants(fields)),
+			constantsByValue(indexConstants(constants)),
+			fieldsByName(indexFields(fields, [] (const FieldDescriptor& descriptor) { return descriptor.name; })),
+			fieldsByDescriptor(indexFields(fields, &descriptorKey)),
+			methods(createMethods(methodsData, classinfo)), methodsByDescriptor(indexMethods(methods)),
 			genericParameters(genericParameters), fieldStringifyContext(getFieldStringifyContext()) {
 
 		if(thisType.isPackageInfo) {
@@ -68,6 +128,70 @@ namespace jdecompiler {
 
 
 	const Class* Class::readClass(ClassInputStream& instream) {
+		Arena& arena = *new Arena();
+		const Arena::Guard arenaGuard(arena);
+
+		try {
+			return readClass(instream, arena);
+		} catch(...) {
+			delete &arena;
+			throw;
+		}
+	}
+
+	string Class::readName(ClassInputStream& instream) {
+		const size_t startPos = instream.getPos();
+
+		if(instream.readUInt() != CLASS_SIGNATURE)
+			throw ClassFormatError("Wrong class signature");
+
+		instream.skip(4); // version
+
+		const uint16_t constPoolSize = instream.readUShort();
+
+		/* For Utf8 constants, the position of the string, for Class constants, the index of the name */
+		vector<uint32_t> constants(constPoolSize);
+
+		for(uint16_t i = 1; i < constPoolSize; i++) {
+			const uint8_t tag = instream.readUByte();
+
+			switch(tag) {
+				case  1: {
+					const uint16_t length = instream.readUShort();
+					constants[i] = static_cast<uint32_t>(instream.getPos());
+					instream.skip(length);
+					break;
+				}
+				case  7: constants[i] = instream.readUShort(); break;
+				case  5: case  6: instream.skip(8); i++; break;
+				case  3: case  4: case  9: case 10: case 11: case 12: case 17: case 18: instream.skip(4); break;
+				case 15: instream.skip(3); break;
+				case  8: case 16: case 19: case 20: instream.skip(2); break;
+				default:
+					throw ClassFormatError("Illegal constant type " + hexWithPrefix<2>(tag) + " at index #" + to_string(i) +
+							" at pos " + hexWithPrefix((uint32_t)instream.getPos()));
+			}
+		}
+
+		instream.skip(2); // modifiers
+
+		const uint16_t thisClassIndex = instream.readUShort();
+
+		if(thisClassIndex == 0 || thisClassIndex >= constPoolSize || constants[thisClassIndex] == 0 || constants[thisClassIndex] >= constPoolSize)
+			throw ClassFormatError("Invalid this class index " + hexWithPrefix<4>(thisClassIndex));
+
+		const uint16_t nameIndex = static_cast<uint16_t>(constants[thisClassIndex]);
+
+		instream.setPos(constants[nameIndex] - 2);
+		const uint16_t length = instream.readUShort();
+		const string name(instream.readString(length), length);
+
+		instream.setPos(startPos);
+
+		return name;
+	}
+
+	const Class* Class::readClass(ClassInputStream& instream, Arena& arena) {
 		if(instream.readUInt() != CLASS_SIGNATURE)
 			throw ClassFormatError("Wrong class signature");
 
@@ -81,7 +205,7 @@ namespace jdecompiler {
 
 		const uint16_t modifiers = instream.readUShort();
 
-		const ClassType& thisType = *new ClassType(constPool.get<ClassConstant>(instream.readUShort()));
+		const ClassType& thisType = *ClassType::getInstance(constPool.get<ClassConstant>(instream.readUShort()));
 		const ClassConstant* superClassConstant = constPool.getNullable<ClassConstant>(instream.readUShort());
 		const ClassType* superType;
 
@@ -90,7 +214,7 @@ namespace jdecompiler {
 				throw DecompilationException("Class " + thisType.getName() + " has no super class");
 			superType = nullptr;
 		} else {
-			superType = new ClassType(superClassConstant);
+			superType = ClassType::getInstance(superClassConstant);
 		}
 
 		const uint16_t interfacesCount = instream.readUShort();
@@ -98,7 +222,7 @@ namespace jdecompiler {
 		interfaces.reserve(interfacesCount);
 
 		for(uint16_t i = 0; i < interfacesCount; ++i)
-			interfaces.push_back(new ClassType(constPool.get<ClassConstant>(instream.readUShort())->name));
+			interfaces.push_back(ClassType::getInstance(constPool.get<ClassConstant>(instream.readUShort())));
 
 
 		const uint16_t fieldsCount = instream.readUShort();
@@ -135,15 +259,16 @@ namespace jdecompiler {
 		}
 
 		return modifiers & ACC_ENUM ?
-			createClass<EnumClass>(instream, version, thisType, superType, constPool, modifiers, interfaces,
+			createClass<EnumClass>(arena, version, thisType, superType, constPool, modifiers, interfaces,
 					attributes, fieldsData, methodsData, genericParameters) :
-			createClass<Class>    (instream, version, thisType, superType, constPool, modifiers, interfaces,
+			createClass<Class>    (arena, version, thisType, superType, constPool, modifiers, interfaces,
 					attributes, fieldsData, methodsData, genericParameters);
 	}
 
-	/* Hacking function: it is necessary to add this Class* to the JDecompiler::decompilationClasses BEFORE initializing fields and methods */
+	/* Hacking function: this Class* must be visible through JDecompiler::getClass BEFORE initializing fields and methods.
+	   The class is added to JDecompiler::classes and JDecompiler::decompilationClasses in JDecompiler::readClassFiles */
 	template<class C>
-	inline const Class* Class::createClass(ClassInputStream& instream, const Version& version, const ClassType& thisType, const ClassType* superType,
+	inline const Class* Class::createClass(Arena& arena, const Version& version, const ClassType& thisType, const ClassType* superType,
 			const ConstantPool& constPool, uint16_t modifiers, const vector<const ClassType*>& interfaces,
 			const Attributes& attributes, const vector<FieldDataHolder>& fieldsData, const vector<MethodDataHolder>& methodsData,
 			const vector<const GenericParameter*>& genericParameters) {
@@ -152,67 +277,129 @@ namespace jdecompiler {
 
 		C* clazz = static_cast<C*>(operator new(sizeof(C)));
 
-		static const regex classExtension("\\.class$");
-		static const JDecompiler& jdecompiler = JDecompiler::getInstance();
+		/* Classes loaded from the jvm are read while the other class is being read */
+		const ClassType* const previousReadingClassType = JDecompiler::readingClassType;
+		const Class* const previousReadingClass = JDecompiler::readingClass;
+
+		JDecompiler::readingClassType = &thisType;
+		JDecompiler::readingClass = clazz;
+
+		try {
+			new(clazz) C(version, thisType, superType, constPool, modifiers, interfaces, attributes, fieldsData, methodsData, genericParameters);
+		} catch(...) {
+			JDecompiler::readingClassType = previousReadingClassType;
+			JDecompiler::readingClass = previousReadingClass;
+			operator delete(clazz);
+			throw;
+		}
+
+		JDecompiler::readingClassType = previousReadingClassType;
+		JDecompiler::readingClass = previousReadingClass;
 
-		jdecompiler.classes.emplace(thisType.getEncodedName(), clazz);
-		jdecompiler.decompilationClasses.emplace(thisType.getEncodedName(),
-				ClassHolder(regex_replace(instream.fileName, classExtension, "") + ".java", clazz));
+		static_cast<Class*>(clazz)->arena = &arena;
 
-		return new(clazz) C(version, thisType, superType, constPool, modifiers, interfaces, attributes, fieldsData, methodsData, genericParameters);
+		return clazz;
 	}
 
 
 	const Field* Class::getField(const string& name) const {
-		for(const Field* field : fields)
-			if(field->descriptor.name == name)
-				return field;
-		return nullptr;
+		const auto found = fieldsByName.find(name);
+		return found == fieldsByName.end() ? nullptr : found->second.front();
 	}
 
+	/* Fields and methods with the same key are still compared, because types of different kinds can have the same encoded name */
 	const Field* Class::getField(const FieldDescriptor& descriptor) const {
-		for(const Field* field : fields)
-			if(field->descriptor == descriptor)
-				return field;
+		const auto found = fieldsByDescriptor.find(descriptorKey(descriptor));
+
+		if(found != fieldsByDescriptor.end())
+			for(const Field* field : found->second)
+				if(field->descriptor == descriptor)
+					return field;
+
 		return nullptr;
 	}
 
 	const Method* Class::getMethod(const MethodDescriptor& descriptor) const {
-		const auto& result = find_if(methods.begin(), methods.end(),
-				[&descriptor] (const Method* method) { return method->descriptor.equalsIgnoreClass(descriptor); });
-		return result == methods.end() ? nullptr : *result;
+		const auto found = methodsByDescriptor.find(descriptorKey(descriptor));
+
+		if(found != methodsByDescriptor.end())
+			for(const Method* method : found->second)
+				if(method->descriptor.equalsIgnoreClass(descriptor))
+					return method;
+
+		return nullptr;
+	}
+
+	const OverloadSet& Class::getOverloadSet(const string& name, size_t argumentsCount, bool isStatic) const {
+		const lock_guard<mutex> lock(overloadSetsMutex);
+
+		const tuple<string, size_t, bool> key(name, argumentsCount, isStatic);
+		const auto found = overloadSets.find(key);
+
+		if(found != overloadSets.end())
+			return found->second;
+
+		// From a non-static context, we can invoke both non-static and static methods
+		return overloadSets.emplace(key, getMethods([&name, argumentsCount, isStatic] (const Method* method) {
+			return (!isStatic || method->isStatic()) && method->descriptor.name == name && method->descriptor.arguments.size() == argumentsCount;
+		})).first->second;
+	}
+
+
+	void Class::releaseCode() const {
+		arena->release();
+
+		const NestMembersAttribute* nestMembers = attributes.get<NestMembersAttribute>();
+
+		if(nestMembers != nullptr) {
+			for(const ClassType* nestMember : nestMembers->nestMembers) {
+				const Class* nestClass = JDecompiler::getInstance().findLoadedClass(nestMember->getEncodedName());
+
+				if(nestClass != nullptr && !nestClass->canStringify())
+					nestClass->arena->release();
+			}
+		}
 	}
 
 
 	string Class::anonymousToString(const ClassInfo& classinfo) const {
-		return thisType.isAnonymous ? toString0<true>(classinfo) : throw IllegalStateException("invokation of anonymousToString in a non-anonymous class");
+		if(!thisType.isAnonymous)
+			throw IllegalStateException("invokation of anonymousToString in a non-anonymous class");
+
+		OutputWriter out;
+		write0<true>(out, classinfo);
+		return out.release();
 	}
 
 
 
 	template<bool isAnonymous>
-	string Class::toString0(const ClassInfo& classinfo) const {
-		string str;
+	void Class::write0(OutputWriter& out, const ClassInfo& classinfo) const {
+		const size_t startPos = out.size();
 
-		str += annotationsToString(classinfo);
+		out << annotationsToString(classinfo);
 
-		str += (isAnonymous ? anonymousDeclarationToString(classinfo) : declarationToString(classinfo)) + " {\n";
+		out << (isAnonymous ? anonymousDeclarationToString(classinfo) : declarationToString(classinfo)) << " {\n";
 
-		const size_t baseSize = str.size();
+		const size_t baseSize = out.size();
 
 		classinfo.increaseIndent();
 
-		str += bodyToString(classinfo);
+		writeBody(out, classinfo);
 
 		classinfo.reduceIndent();
 
-		if(str.size() == baseSize)
-			str.back() = '}';
-		else
-			str += (str.back() == '\n' ? EMPTY_STRING : "\n") + classinfo.getIndent() + '}';
+		if(out.size() == baseSize) {
+			out.back() = '}';
+		} else {
+			if(out.back() != '\n')
+				out << '\n';
 
+			out << classinfo.getIndent() << '}';
+		}
 
-		return headersToString(classinfo) + str;
+		/* Imports are known only after the body is written */
+		out.insert(startPos, headersToString(classinfo));
 	}
 
 	inline string Class::annotationsToString(const ClassInfo& classinfo) const {
@@ -374,41 +561,33 @@ namespace jdecompiler {
 	}
 
 
-	string Class::fieldsToString(const ClassInfo& classinfo) const {
-		string str;
-
+	void Class::writeFields(OutputWriter& out, const ClassInfo& classinfo) const {
 		bool anyFieldStringified = false;
 
 		for(const Field* field : fields) {
 			if(field->canStringify(classinfo)) {
-				str += '\n' + field->toString(fieldStringifyContext) + ';';
+				out << '\n' << field->toString(fieldStringifyContext) << ';';
 				anyFieldStringified = true;
 			}
 		}
 
 		if(anyFieldStringified)
-			str += '\n';
-
-		return str;
+			out << '\n';
 	}
 
 
-	string Class::methodsToString(const ClassInfo& classinfo) const {
-		string str;
-
+	void Class::writeMethods(OutputWriter& out, const ClassInfo& classinfo) const {
 		for(const Method* method : methods) {
 			if(method->canStringify(classinfo)) {
 				log("stringify of", method->descriptor.toString());
-				str += '\n' + method->toString(classinfo) + '\n';
+				out << '\n';
+				method->writeTo(out, classinfo);
+				out << '\n';
 			}
 		}
-
-		return str;
 	}
 
-	string Class::innerClassesToString(const ClassInfo& classinfo) const {
-		string str;
-
+	void Class::writeInnerClasses(OutputWriter& out, const ClassInfo& classinfo) const {
 		const NestMembersAttribute* nestMembers = attributes.get<NestMembersAttribute>();
 
 		if(nestMembers != nullptr) {
@@ -420,16 +599,18 @@ namespace jdecompiler {
 				const Class* nestClass = JDecompiler::getInstance().getClass(nestMember->getClassEncodedName());
 
 				if(nestClass != nullptr) {
+					const lock_guard<recursive_mutex> lock(nestClass->classinfo.getFormattingMutex());
+
 					nestClass->classinfo.copyFormattingFrom(classinfo);
-					str += '\n' + nestClass->toString() + '\n';
+					out << '\n';
+					nestClass->writeTo(out);
+					out << '\n';
 					nestClass->classinfo.resetFormatting();
 				} else {
 					warning("cannot load inner class " + nestMember->getName());
 				}
 			}
 		}
-
-		return str;
 	}
 }
 
@@ -6,6 +6,40 @@
 
 namespace jdecompiler {
 
+	/* Methods of a class with the same name and count of arguments, which can be invoked from a static or non-static context.
+	   Also remembers the result of the overload resolution for each invoked descriptor and types of the arguments */
+	struct OverloadSet {
+		public:
+			const vector<const Method*> methods;
+
+		private:
+			mutable map<vector<const Type*>, bool> resolutions;
+			mutable mutex resolutionsMutex;
+
+		public:
+			OverloadSet(const vector<const Method*>& methods): methods(methods) {}
+
+			/* The key contains the types of the invoked descriptor and the implicit types of the arguments.
+			   The resolver is called only for the first occurrence of the key */
+			template<typename F>
+			bool resolve(const vector<const Type*>& key, const F& resolver) const {
+				{
+					const lock_guard<mutex> lock(resolutionsMutex);
+
+					const auto found = resolutions.find(key);
+					if(found != resolutions.end())
+						return found->second;
+				}
+
+				const bool result = resolver();
+
+				const lock_guard<mutex> lock(resolutionsMutex);
+				resolutions.emplace(key, result);
+				return result;
+			}
+	};
+
+
 	struct Class: ClassElement {
 		public:
 			const Version version;
@@ -15,16 +49,53 @@ namespace jdecompiler {
 			const Attributes& attributes;
 			const ClassInfo& classinfo;
 			const vector<const Field*> fields, constants;
+
+		private:
+			template<typename T>
+			using ConstantsByValue = umap<T, vector<const Field*>>;
+
+			using ConstantsIndex = tuple<ConstantsByValue<jint>, ConstantsByValue<jlong>,
+					ConstantsByValue<jfloat>, ConstantsByValue<jdouble>, ConstantsByValue<string>>;
+
+			/* Constant fields by the type and the value of the constant */
+			const ConstantsIndex constantsByValue;
+
+			static ConstantsIndex indexConstants(const vector<const Field*>&);
+
+			/* Fields by name and by name and type. Fields and methods with the same key are kept in the order of declaration */
+			const umap<string, vector<const Field*>> fieldsByName, fieldsByDescriptor;
+
+			static string descriptorKey(const FieldDescriptor&);
+			static umap<string, vector<const Field*>> indexFields(const vector<const Field*>&, string(*)(const FieldDescriptor&));
+
+		public:
 			const vector<const Method*> methods;
+
+		private:
+			/* Methods by name, arguments and return type */
+			const umap<string, vector<const Method*>> methodsByDescriptor;
+
+			static string descriptorKey(const MethodDescriptor&);
+			static umap<string, vector<const Method*>> indexMethods(const vector<const Method*>&);
+
+		public:
 			const vector<const GenericParameter*> genericParameters;
 
 			const StringifyContext& fieldStringifyContext;
 
 		private:
+			/* Owns the decompiled code of the class */
+			Arena* arena = nullptr;
+
+			mutable map<tuple<string, size_t, bool>, OverloadSet> overloadSets;
+			mutable mutex overloadSetsMutex;
+
 			const vector<const Field*> createFields(const vector<FieldDataHolder>&, const ClassInfo&) const;
 			const vector<const Method*> createMethods(const vector<MethodDataHolder>&, const ClassInfo&) const;
 			const StringifyContext& getFieldStringifyContext();
 
+			static const Class* readClass(ClassInputStream&, Arena&);
+
 			static inline const vector<const Field*> filterConstants(const vector<const Field*>& fields) {
 				return copy_if<const Field*>(fields, [] (const Field* field) { return field->isConstant(); });
 			}
@@ -40,8 +111,11 @@ namespace jdecompiler {
 		public:
 			static const Class* readClass(ClassInputStream&);
 
+			/* Reads only the name of the class, without creating the constant pool. The position of the stream is not changed */
+			static string readName(ClassInputStream&);
+
 			template<class>
-			static const Class* createClass(ClassInputStream&, const Version&, const ClassType&, const ClassType*, const ConstantPool&, modifiers_t,
+			static const Class* createClass(Arena&, const Version&, const ClassType&, const ClassType*, const ConstantPool&, modifiers_t,
 					const vector<const ClassType*>&, const Attributes&, const vector<FieldDataHolder>&, const vector<MethodDataHolder>&,
 					const vector<const GenericParameter*>&);
 
@@ -53,9 +127,24 @@ namespace jdecompiler {
 				return fields;
 			}
 
+			/* Returns the constant fields which have the constant value of type T equal to the value */
+			template<typename T>
+			const vector<const Field*>& getConstants(const T& value) const {
+				static const vector<const Field*> EMPTY;
+
+				const ConstantsByValue<T>& constantsMap = std::get<ConstantsByValue<T>>(constantsByValue);
+				const auto found = constantsMap.find(value);
+
+				return found != constantsMap.end() ? found->second : EMPTY;
+			}
+
 
 			const Method* getMethod(const MethodDescriptor&) const;
 
+			/* Returns the methods with the name and the count of arguments which can be invoked from
+			   a static or non-static context. The set is created once and shared by all the call sites */
+			const OverloadSet& getOverloadSet(const string& name, size_t argumentsCount, bool isStatic) const;
+
 			inline bool hasMethod(const MethodDescriptor& descriptor) const {
 				return getMethod(descriptor) != nullptr;
 			}
@@ -71,24 +160,41 @@ namespace jdecompiler {
 
 		protected:
 			virtual string toString(const ClassInfo& classinfo) const override {
-				return thisType.isPackageInfo ? packageInfoToString(classinfo) : toString0<false>(classinfo);
+				OutputWriter out;
+				writeTo(out, classinfo);
+				return out.release();
+			}
+
+			void writeTo(OutputWriter& out, const ClassInfo& classinfo) const {
+				if(thisType.isPackageInfo)
+					out << packageInfoToString(classinfo);
+				else
+					write0<false>(out, classinfo);
 			}
 
 			virtual string anonymousToString(const ClassInfo&) const;
 
 		public:
 			inline string toString() const {
+				const lock_guard<recursive_mutex> lock(classinfo.getFormattingMutex());
 				return toString(classinfo);
 			}
 
+			/* Writes the source of the class to the end of the output */
+			inline void writeTo(OutputWriter& out) const {
+				const lock_guard<recursive_mutex> lock(classinfo.getFormattingMutex());
+				writeTo(out, classinfo);
+			}
+
 			inline string anonymousToString() const {
+				const lock_guard<recursive_mutex> lock(classinfo.getFormattingMutex());
 				return anonymousToString(classinfo);
 			}
 
 
 		protected:
 			template<bool>
-			string toString0(const ClassInfo&) const;
+			void write0(OutputWriter&, const ClassInfo&) const;
 
 			string annotationsToString(const ClassInfo&) const;
 
@@ -110,22 +216,32 @@ namespace jdecompiler {
 			string modifiersToString(modifiers_t) const;
 
 
-			virtual string bodyToString(const ClassInfo& classinfo) const {
-				return fieldsToString(classinfo) + methodsToString(classinfo) + innerClassesToString(classinfo);
+			virtual void writeBody(OutputWriter& out, const ClassInfo& classinfo) const {
+				writeFields(out, classinfo);
+				writeMethods(out, classinfo);
+				writeInnerClasses(out, classinfo);
 			}
 
 
-			virtual string fieldsToString(const ClassInfo&) const;
+			virtual void writeFields(OutputWriter&, const ClassInfo&) const;
 
-			virtual string methodsToString(const ClassInfo&) const;
+			virtual void writeMethods(OutputWriter&, const ClassInfo&) const;
 
-			virtual string innerClassesToString(const ClassInfo&) const;
+			virtual void writeInnerClasses(OutputWriter&, const ClassInfo&) const;
 
 
 		public:
+			inline Arena& getArena() const {
+				return *arena;
+			}
+
+			/* Destroys the decompiled code of the class and its nest members after they are written.
+			   The class must not be stringified after that */
+			void releaseCode() const;
+
 			inline bool canStringify() const {
 				return !((modifiers & ACC_SYNTHETIC && !JDecompiler::getInstance().showSynthetic() && !thisType.isPackageInfo) ||
-						(thisType.isNested && JDecompiler::getInstance().hasClass(thisType.enclosingClass->getEncodedName())));
+						(thisType.isNested && JDecompiler::getInstance().hasInputClass(thisType.enclosingClass->getEncodedName())));
 			}
 
 			virtual bool canStringify(const ClassInfo&) const override {
@@ -135,7 +251,7 @@ namespace jdecompiler {
 		protected:
 			template<typename T>
 			inline void warning(const T& message) const {
-				cerr << thisType.toString() << ": warning: " << message << endl;
+				JDecompiler::getErrorStream() << thisType.toString() << ": warning: " << message << endl;
 			}
 	};
 
@@ -148,6 +264,11 @@ namespace jdecompiler {
 		return clazz.constants;
 	}
 
+	template<typename T>
+	inline const vector<const Field*>& ClassInfo::getConstants(const T& value) const {
+		return clazz.getConstants(value);
+	}
+
 	inline const vector<const Method*>& ClassInfo::getMethods() const {
 		return clazz.methods;
 	}
@@ -165,6 +286,65 @@ namespace jdecompiler {
 	}
 
 
+	inline const Class* JDecompiler::getClass(const string& name) const {
+		if(readingClass != nullptr && readingClassType->getEncodedName() == name)
+			return readingClass;
+
+		ClassSource* source;
+
+		{
+			const lock_guard<recursive_mutex> lock(classesMutex);
+
+			const auto& sourceIterator = sourcesByName.find(name);
+			source = sourceIterator != sourcesByName.end() ? sourceIterator->second : nullptr;
+
+			/* While an input class is read, only the classes before it are visible, as if the classes are read one by one */
+			if(source != nullptr && readingSource != nullptr && source->index >= readingSource->index)
+				return nullptr;
+
+			const auto& classIterator = classes.find(name);
+			if(classIterator != classes.end() && (classIterator->second != nullptr || source == nullptr))
+				return classIterator->second;
+
+			if(source == nullptr) {
+				const bool previousLoadingFromJvm = loadingFromJvm;
+				loadingFromJvm = true;
+
+				const Class* clazz = classes[name] = (jvm != nullptr ? jvm->loadClass(name.c_str()) : nullptr);
+
+				loadingFromJvm = previousLoadingFromJvm;
+				return clazz;
+			}
+
+			/* The lock is held while a class is loaded from the jvm, so the input classes are not read then */
+			if(loadingFromJvm)
+				return nullptr;
+		}
+
+		/* Classes are read when they are needed for the first time. The lock is not held while reading,
+		   because other threads can read the same class. A class needed while another one is read is registered later,
+		   in the order of the files */
+		return readingSource != nullptr ? readClassSource(*source) : loadClassSource(*source);
+	}
+
+	inline const Class* JDecompiler::findLoadedClass(const string& name) const {
+		if(readingClass != nullptr && readingClassType->getEncodedName() == name)
+			return readingClass;
+
+		const lock_guard<recursive_mutex> lock(classesMutex);
+
+		const auto& classIterator = classes.find(name);
+		return classIterator != classes.end() ? classIterator->second : nullptr;
+	}
+
+	inline bool JDecompiler::hasInputClass(const string& name) const {
+		if(findLoadedClass(name) != nullptr)
+			return true;
+
+		const lock_guard<recursive_mutex> lock(classesMutex);
+		return sourcesByName.find(name) != sourcesByName.end();
+	}
+
 	inline const ClassInfo* JDecompiler::getClassInfo(const string& name) const {
 		const Class* clazz = getClass(name);
 		return clazz != nullptr ? &clazz->classinfo : nullptr;
@@ -24,54 +24,59 @@ namespace jdecompiler {
 			static const char* const EMPTY_INDENT;
 
 		private:
-			mutable vector<const ClassType*> imports;
+			/* Imported classes by encoded name and by simple name. Each simple name is imported at most once */
+			mutable umap<string, const ClassType*> importsByName, importsBySimpleName;
 
 			mutable uint16_t indentWidth = 0;
 			mutable const char* indent = EMPTY_INDENT;
 
+			/* The indents are the same for all classes, so each one is built once per run */
+			static const char* indentFor(uint16_t width);
+
+			/* Guards imports and indent: the class can be stringified by the enclosing class in another thread */
+			mutable recursive_mutex formattingMutex;
+
 		public:
+			inline recursive_mutex& getFormattingMutex() const {
+				return formattingMutex;
+			}
+
 			bool addImport(const ClassType*) const;
 
 			string importsToString() const;
 
 			inline void copyFormattingFrom(const ClassInfo& other) const {
 				indentWidth = other.indentWidth;
-				indent = repeatString(JDecompiler::getInstance().getIndent(), indentWidth);
-				imports = other.imports;
+				indent = other.indent;
+				importsByName = other.importsByName;
+				importsBySimpleName = other.importsBySimpleName;
 			}
 
 			inline void resetFormatting() const {
 				indentWidth = 0;
 				indent = EMPTY_INDENT;
-				imports.clear();
+				importsByName.clear();
+				importsBySimpleName.clear();
 			}
 
 			inline const char* getIndent() const {
 				return indent;
 			}
 
-			void increaseIndent() const {
-				if(indent != EMPTY_INDENT)
-					delete[] indent;
-				indent = repeatString(JDecompiler::getInstance().getIndent(), ++indentWidth);
+			inline void increaseIndent() const {
+				indent = indentFor(++indentWidth);
 			}
 
-			void increaseIndent(uint16_t count) const {
-				if(indent != EMPTY_INDENT)
-					delete[] indent;
-				indent = repeatString(JDecompiler::getInstance().getIndent(), indentWidth += count);
+			inline void increaseIndent(uint16_t count) const {
+				indent = indentFor(indentWidth += count);
 			}
 
-			void reduceIndent() const {
-				if(indent != EMPTY_INDENT)
-					delete[] indent;
-				indent = repeatString(JDecompiler::getInstance().getIndent(), --indentWidth);
+			inline void reduceIndent() const {
+				indent = indentFor(--indentWidth);
 			}
 
-			void reduceIndent(uint16_t count) const {
-				if(indent != EMPTY_INDENT)
-					delete[] indent;
-				indent = repeatString(JDecompiler::getInstance().getIndent(), indentWidth -= count);
+			inline void reduceIndent(uint16_t count) const {
+				indent = indentFor(indentWidth -= count);
 			}
 
 
@@ -79,6 +84,9 @@ namespace jdecompiler {
 
 			const vector<const Field*>& getConstants() const;
 
+			template<typename T>
+			const vector<const Field*>& getConstants(const T& value) const;
+
 			const vector<const Method*>& getMethods() const;
 			const vector<const Method*> getMethods(const function<bool(const Method*)>&) const;
 			const Method* getMethod(const MethodDescriptor&) const;
@@ -88,6 +96,7 @@ namespace jdecompiler {
 		private:
 			mutable const StringifyContext* fieldStringifyContext = nullptr;
 			mutable const DisassemblerContext* emptyDisassemblerContext = nullptr;
+			mutable once_flag emptyDisassemblerContextFlag;
 
 		public:
 			const DisassemblerContext& getEmptyDisassemblerContext() const;
@@ -99,6 +108,44 @@ namespace jdecompiler {
 	};
 
 	const char* const ClassInfo::EMPTY_INDENT = "";
+
+
+	const char* ClassInfo::indentFor(uint16_t width) {
+		static constexpr uint16_t PRECOMPUTED_INDENTS = 64;
+
+		static const vector<string> indents = [] () {
+			vector<string> result;
+			result.reserve(PRECOMPUTED_INDENTS);
+
+			string indent;
+
+			for(uint16_t i = 0; i < PRECOMPUTED_INDENTS; i++) {
+				result.push_back(indent);
+				indent += JDecompiler::getInstance().getIndent();
+			}
+
+			return result;
+		}();
+
+		if(width < PRECOMPUTED_INDENTS)
+			return indents[width].c_str();
+
+		/* Such deep nesting is rare, so these indents are built on demand */
+		static map<uint16_t, string> deepIndents;
+		static mutex deepIndentsMutex;
+
+		const lock_guard<mutex> lock(deepIndentsMutex);
+
+		const auto found = deepIndents.find(width);
+		if(found != deepIndents.end())
+			return found->second.c_str();
+
+		string indent;
+		for(uint16_t i = 0; i < width; i++)
+			indent += JDecompiler::getInstance().getIndent();
+
+		return deepIndents.emplace(width, indent).first->second.c_str();
+	}
 }
 
 #endif
@@ -3,51 +3,108 @@
 
 namespace jdecompiler {
 
-	struct CodeStack: stack<const Operation*> {
-		inline const Operation* popAs(const Type* type) {
-			const Operation* operation = this->pop();
-			operation->castReturnTypeTo(type);
-			return operation;
-		}
-
-		CodeStack() {}
-
-		inline const Operation* pop() {
-			try {
-				return stack<const Operation*>::pop();
-			} catch(const EmptyStackException& ex) {
-				throw EmptyCodeStackException(ex);
-			}
-		}
-
-		inline const Operation* top() {
-			try {
-				return stack<const Operation*>::top();
-			} catch(const EmptyStackException& ex) {
-				throw EmptyCodeStackException(ex);
-			}
-		}
-
-		inline const Operation* lookup(size_t index) {
-			try {
-				return stack<const Operation*>::lookup(index);
-			} catch(const EmptyStackException& ex) {
-				throw EmptyCodeStackException(ex);
-			}
-		}
-
-		template<class O>
-		inline O pop() {
-			checkEmptyStack();
-
-			O operation = stack<const Operation*>::pop();
-			if(const O* t = dynamic_cast<const O*>(operation))
-				return t;
-			throw DecompilationException("Illegal operation type " + typenameof<O>() + " for operation " + typenameof(*operation));
-		}
-
-		CodeStack(const CodeStack&) = delete;
-		CodeStack& operator=(const CodeStack&) = delete;
+	/* The operand stack of a method. Operations are kept in a contiguous buffer: the inline buffer for small stacks,
+	   or a heap buffer sized from max_stack of the method. The buffer grows only if the bytecode exceeds max_stack */
+	struct CodeStack {
+		private:
+			static constexpr size_t INLINE_CAPACITY = 16;
+
+			const Operation* inlineBuffer[INLINE_CAPACITY];
+			const Operation** data = inlineBuffer;
+			size_t length = 0, capacity = INLINE_CAPACITY;
+
+			void reserve(size_t newCapacity) {
+				const Operation** newData = new const Operation*[newCapacity];
+				std::copy(data, data + length, newData);
+
+				if(data != inlineBuffer)
+					delete[] data;
+
+				data = newData;
+				capacity = newCapacity;
+			}
+
+			inline void checkSize(size_t requiredSize) const {
+				if(length < requiredSize) {
+					if(length == 0)
+						throw EmptyCodeStackException();
+
+					throw StackIndexOutOfBoundsException(requiredSize - 1, length);
+				}
+			}
+
+		public:
+			explicit CodeStack(uint16_t maxStack = 0) {
+				if(maxStack > INLINE_CAPACITY)
+					reserve(maxStack);
+			}
+
+			CodeStack(const CodeStack&) = delete;
+			CodeStack& operator=(const CodeStack&) = delete;
+
+			~CodeStack() {
+				if(data != inlineBuffer)
+					delete[] data;
+			}
+
+
+			inline size_t size() const {
+				return length;
+			}
+
+			inline bool empty() const {
+				return length == 0;
+			}
+
+			inline void push(const Operation* operation) {
+				if(length == capacity)
+					reserve(capacity * 2);
+
+				data[length++] = operation;
+			}
+
+			inline const Operation* pop() {
+				checkSize(1);
+				return data[--length];
+			}
+
+			inline const Operation* popAs(const Type* type) {
+				const Operation* operation = this->pop();
+				operation->castReturnTypeTo(type);
+				return operation;
+			}
+
+			template<class O>
+			inline const O* pop() {
+				const Operation* operation = this->pop();
+
+				if(const O* result = dynamic_cast<const O*>(operation))
+					return result;
+
+				throw DecompilationException("Illegal operation type " + typenameof<O>() + " for operation " + typenameof(*operation));
+			}
+
+			inline const Operation* top() const {
+				checkSize(1);
+				return data[length - 1];
+			}
+
+			/* Returns the operation at the index from the top of the stack */
+			inline const Operation* lookup(size_t index) const {
+				checkSize(index + 1);
+				return data[length - 1 - index];
+			}
+
+			inline void swap() {
+				checkSize(2);
+				std::swap(data[length - 1], data[length - 2]);
+			}
+
+			/* Moves the top operation under the depth operations below it, as dup_x1 and dup_x2 do before pushing the copy */
+			inline void moveTopDown(size_t depth) {
+				checkSize(depth + 1);
+				std::rotate(data + length - 1 - depth, data + length - 1, data + length);
+			}
 	};
 }
 
@@ -126,6 +126,31 @@ namespace jdecompiler {
 			inline const Utf8Constant& getUtf8Constant(uint16_t index) const {
 				return *get<Utf8Constant>(index);
 			}
+
+
+		private:
+			/* Descriptors parsed from the Class, Fieldref and Methodref constants by the index of the constant */
+			mutable umap<uint16_t, const ReferenceType*> referenceTypes;
+			mutable umap<uint16_t, const FieldDescriptor*> fieldDescriptors;
+			mutable umap<uint16_t, const MethodDescriptor*> methodDescriptors;
+			mutable mutex descriptorsMutex;
+
+			template<typename T, typename F>
+			const T& getParsed(umap<uint16_t, const T*>& parsed, uint16_t index, const F& parser) const {
+				const lock_guard<mutex> lock(descriptorsMutex);
+
+				const auto found = parsed.find(index);
+				if(found != parsed.end())
+					return *found->second;
+
+				return *parsed.emplace(index, parser()).first->second;
+			}
+
+		public:
+			/* Each descriptor is parsed once, by the first instruction which refers to it */
+			const ReferenceType* getReferenceType(uint16_t classIndex) const;
+			const FieldDescriptor& getFieldDescriptor(uint16_t fieldrefIndex) const;
+			const MethodDescriptor& getMethodDescriptor(uint16_t methodrefIndex) const;
 	};
 
 
@@ -366,6 +391,8 @@ namespace jdecompiler {
 	ConstantPool::ConstantPool(ClassInputStream& instream): size(instream.readUShort()),
 			pool(new const Constant*[size]), interPool(new const InterConstant*[size]) {
 
+		const Stats::Timer timer(Stats::Phase::CONSTANT_POOL);
+
 		for(uint16_t i = 0; i < size; i++) {
 			pool[i] = nullptr;
 			interPool[i] = nullptr;
@@ -379,7 +406,6 @@ namespace jdecompiler {
 					uint16_t length = instream.readUShort();
 					const char* bytes = instream.readString(length);
 					pool[i] = new Utf8Constant(bytes, length);
-					delete[] bytes;
 					break;
 				}
 				case  3:
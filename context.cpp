@@ -1,13 +1,15 @@
 #ifndef JDECOMPILER_CONTEXT_CPP
 #define JDECOMPILER_CONTEXT_CPP
 
+#include "start-index-queue.cpp"
+
 namespace jdecompiler {
 
-	struct Context {
+	struct Context: ArenaObject {
 		public:
 			pos_t pos = 0;
 
-			constexpr Context() noexcept {}
+			Context() noexcept {}
 
 			Context(const Context&) = delete;
 
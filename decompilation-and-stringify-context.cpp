@@ -20,7 +20,7 @@ namespace jdecompiler {
 			const Attributes& attributes;
 
 		protected:
-			mutable vector<const Scope*> inactiveScopes;
+			mutable StartIndexQueue<Scope> inactiveScopes;
 
 			DecompilationAndStringifyContext(const DisassemblerContext& disassemblerContext, const ClassInfo& classinfo,
 					MethodScope& methodScope, modifiers_t modifiers, const MethodDescriptor& descriptor, const Attributes& attributes):
@@ -33,7 +33,8 @@ namespace jdecompiler {
 			}
 
 			inline void addScope(const Scope* scope) const {
-				inactiveScopes.push_back(scope);
+				inactiveScopes.push(scope);
+				Stats::count(Stats::Counter::SCOPES);
 			}
 
 			inline index_t posToIndex(pos_t pos) const {
@@ -55,7 +56,7 @@ namespace jdecompiler {
 
 			template<typename... Args>
 			inline void warning(Args... args) const {
-				print(cerr << descriptor.toString() << ':' << pos << ": warning: ", args...);
+				print(JDecompiler::getErrorStream() << descriptor.toString() << ':' << pos << ": warning: ", args...);
 			}
 	};
 }
@@ -12,10 +12,11 @@ namespace jdecompiler {
 			CodeStack& stack;
 
 			index_t index = 0, exprStartIndex = 0;
-			map<uint32_t, index_t> exprIndexTable;
+			/* The index of the expression for each instruction index */
+			vector<index_t> exprIndexTable;
 
 			DecompilationContext(const DisassemblerContext&, const ClassInfo&,
-					MethodScope*, modifiers_t, const MethodDescriptor&, const Attributes&, uint16_t maxLocals);
+					MethodScope*, modifiers_t, const MethodDescriptor&, const Attributes&, uint16_t maxLocals, uint16_t maxStack);
 
 
 			void updateScopes();
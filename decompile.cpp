@@ -5,6 +5,43 @@
 
 namespace jdecompiler {
 
+	/* Instructions without operands and instructions with operands encoded in the opcode do not depend on the method,
+	   so a single instance of each of them is shared instead of being allocated for each opcode */
+	template<class I, auto... args>
+	static inline Instruction* sharedInstruction() {
+		static I instance {args...};
+		return &instance;
+	}
+
+	template<class I>
+	static inline Instruction* sharedOperatorInstruction(uint16_t typeCode) {
+		static I instances[] { I(0), I(1), I(2), I(3) };
+		return &instances[typeCode];
+	}
+
+	static inline Instruction* sharedCastInstruction(uint8_t opcode) {
+		static CastInstruction instances[] {
+			{ INT,    LONG,   false }, // int -> long
+			{ INT,    FLOAT,  false }, // int -> float
+			{ INT,    DOUBLE, false }, // int -> double
+			{ LONG,   INT,    true  }, // long -> int
+			{ LONG,   FLOAT,  false }, // long -> float
+			{ LONG,   DOUBLE, false }, // long -> double
+			{ FLOAT,  INT,    true  }, // float -> int
+			{ FLOAT,  LONG,   true  }, // float -> long
+			{ FLOAT,  DOUBLE, false }, // float -> double
+			{ DOUBLE, INT,    true  }, // double -> int
+			{ DOUBLE, LONG,   true  }, // double -> long
+			{ DOUBLE, FLOAT,  true  }, // double -> float
+			{ INT,    BYTE,   true  }, // int -> byte
+			{ INT,    CHAR,   true  }, // int -> char
+			{ INT,    SHORT,  true  }, // int -> short
+		};
+
+		return &instances[opcode - 0x85];
+	}
+
+
 	Instruction* DisassemblerContext::nextInstruction() {
 		switch(current()) {
 			case 0x00: return nullptr;
@@ -37,103 +74,91 @@ namespace jdecompiler {
 			case 0x1B: return new ILoadInstruction(1);
 			case 0x1C: return new ILoadInstruction(2);
 			case 0x1D: return new ILoadInstruction(3);
-			case 0x1E: return new LLoadInstruction(0);
-			case 0x1F: return new LLoadInstruction(1);
-			case 0x20: return new LLoadInstruction(2);
-			case 0x21: return new LLoadInstruction(3);
-			case 0x22: return new FLoadInstruction(0);
-			case 0x23: return new FLoadInstruction(1);
-			case 0x24: return new FLoadInstruction(2);
-			case 0x25: return new FLoadInstruction(3);
-			case 0x26: return new DLoadInstruction(0);
-			case 0x27: return new DLoadInstruction(1);
-			case 0x28: return new DLoadInstruction(2);
-			case 0x29: return new DLoadInstruction(3);
-			case 0x2A: return new ALoadInstruction(0);
-			case 0x2B: return new ALoadInstruction(1);
-			case 0x2C: return new ALoadInstruction(2);
-			case 0x2D: return new ALoadInstruction(3);
-			case 0x2E: return new IALoadInstruction();
-			case 0x2F: return new LALoadInstruction();
-			case 0x30: return new FALoadInstruction();
-			case 0x31: return new DALoadInstruction();
-			case 0x32: return new AALoadInstruction();
-			case 0x33: return new BALoadInstruction();
-			case 0x34: return new CALoadInstruction();
-			case 0x35: return new SALoadInstruction();
+			case 0x1E: return sharedInstruction<LLoadInstruction, 0>();
+			case 0x1F: return sharedInstruction<LLoadInstruction, 1>();
+			case 0x20: return sharedInstruction<LLoadInstruction, 2>();
+			case 0x21: return sharedInstruction<LLoadInstruction, 3>();
+			case 0x22: return sharedInstruction<FLoadInstruction, 0>();
+			case 0x23: return sharedInstruction<FLoadInstruction, 1>();
+			case 0x24: return sharedInstruction<FLoadInstruction, 2>();
+			case 0x25: return sharedInstruction<FLoadInstruction, 3>();
+			case 0x26: return sharedInstruction<DLoadInstruction, 0>();
+			case 0x27: return sharedInstruction<DLoadInstruction, 1>();
+			case 0x28: return sharedInstruction<DLoadInstruction, 2>();
+			case 0x29: return sharedInstruction<DLoadInstruction, 3>();
+			case 0x2A: return sharedInstruction<ALoadInstruction, 0>();
+			case 0x2B: return sharedInstruction<ALoadInstruction, 1>();
+			case 0x2C: return sharedInstruction<ALoadInstruction, 2>();
+			case 0x2D: return sharedInstruction<ALoadInstruction, 3>();
+			case 0x2E: return sharedInstruction<IALoadInstruction>();
+			case 0x2F: return sharedInstruction<LALoadInstruction>();
+			case 0x30: return sharedInstruction<FALoadInstruction>();
+			case 0x31: return sharedInstruction<DALoadInstruction>();
+			case 0x32: return sharedInstruction<AALoadInstruction>();
+			case 0x33: return sharedInstruction<BALoadInstruction>();
+			case 0x34: return sharedInstruction<CALoadInstruction>();
+			case 0x35: return sharedInstruction<SALoadInstruction>();
 			case 0x36: return new IStoreInstruction(nextUByte());
 			case 0x37: return new LStoreInstruction(nextUByte());
 			case 0x38: return new FStoreInstruction(nextUByte());
 			case 0x39: return new DStoreInstruction(nextUByte());
 			case 0x3A: return new AStoreInstruction(nextUByte());
-			case 0x3B: return new IStoreInstruction(0);
-			case 0x3C: return new IStoreInstruction(1);
-			case 0x3D: return new IStoreInstruction(2);
-			case 0x3E: return new IStoreInstruction(3);
-			case 0x3F: return new LStoreInstruction(0);
-			case 0x40: return new LStoreInstruction(1);
-			case 0x41: return new LStoreInstruction(2);
-			case 0x42: return new LStoreInstruction(3);
-			case 0x43: return new FStoreInstruction(0);
-			case 0x44: return new FStoreInstruction(1);
-			case 0x45: return new FStoreInstruction(2);
-			case 0x46: return new FStoreInstruction(3);
-			case 0x47: return new DStoreInstruction(0);
-			case 0x48: return new DStoreInstruction(1);
-			case 0x49: return new DStoreInstruction(2);
-			case 0x4A: return new DStoreInstruction(3);
-			case 0x4B: return new AStoreInstruction(0);
-			case 0x4C: return new AStoreInstruction(1);
-			case 0x4D: return new AStoreInstruction(2);
-			case 0x4E: return new AStoreInstruction(3);
-			case 0x4F: return new IAStoreInstruction();
-			case 0x50: return new LAStoreInstruction();
-			case 0x51: return new FAStoreInstruction();
-			case 0x52: return new DAStoreInstruction();
-			case 0x53: return new AAStoreInstruction();
-			case 0x54: return new BAStoreInstruction();
-			case 0x55: return new CAStoreInstruction();
-			case 0x56: return new SAStoreInstruction();
-			case 0x57: return new PopInstruction<TypeSize::FOUR_BYTES>();
-			case 0x58: return new PopInstruction<TypeSize::EIGHT_BYTES>();
-			case 0x59: return new Dup1Instruction();
-			case 0x5A: return new DupX1Instruction();
-			case 0x5B: return new DupX2Instruction();
-			case 0x5C: return new Dup2Instruction();
-			case 0x5D: return new Dup2X1Instruction();
-			case 0x5E: return new Dup2X2Instruction();
-			case 0x5F: return new SwapInstruction();
-			case 0x60: case 0x61: case 0x62: case 0x63: return new AddOperatorInstruction(current() & 3);
-			case 0x64: case 0x65: case 0x66: case 0x67: return new SubOperatorInstruction(current() & 3);
-			case 0x68: case 0x69: case 0x6A: case 0x6B: return new MulOperatorInstruction(current() & 3);
-			case 0x6C: case 0x6D: case 0x6E: case 0x6F: return new DivOperatorInstruction(current() & 3);
-			case 0x70: case 0x71: case 0x72: case 0x73: return new RemOperatorInstruction(current() & 3);
-			case 0x74: case 0x75: case 0x76: case 0x77: return new NegOperatorInstruction(current() & 3);
-			case 0x78: case 0x79: return new ShiftLeftOperatorInstruction(current() & 1);
-			case 0x7A: case 0x7B: return new ShiftRightOperatorInstruction(current() & 1);
-			case 0x7C: case 0x7D: return new UShiftRightOperatorInstruction(current() & 1);
-			case 0x7E: case 0x7F: return new AndOperatorInstruction(current() & 1);
-			case 0x80: case 0x81: return new OrOperatorInstruction(current() & 1);
-			case 0x82: case 0x83: return new XorOperatorInstruction(current() & 1);
+			case 0x3B: return sharedInstruction<IStoreInstruction, 0>();
+			case 0x3C: return sharedInstruction<IStoreInstruction, 1>();
+			case 0x3D: return sharedInstruction<IStoreInstruction, 2>();
+			case 0x3E: return sharedInstruction<IStoreInstruction, 3>();
+			case 0x3F: return sharedInstruction<LStoreInstruction, 0>();
+			case 0x40: return sharedInstruction<LStoreInstruction, 1>();
+			case 0x41: return sharedInstruction<LStoreInstruction, 2>();
+			case 0x42: return sharedInstruction<LStoreInstruction, 3>();
+			case 0x43: return sharedInstruction<FStoreInstruction, 0>();
+			case 0x44: return sharedInstruction<FStoreInstruction, 1>();
+			case 0x45: return sharedInstruction<FStoreInstruction, 2>();
+			case 0x46: return sharedInstruction<FStoreInstruction, 3>();
+			case 0x47: return sharedInstruction<DStoreInstruction, 0>();
+			case 0x48: return sharedInstruction<DStoreInstruction, 1>();
+			case 0x49: return sharedInstruction<DStoreInstruction, 2>();
+			case 0x4A: return sharedInstruction<DStoreInstruction, 3>();
+			case 0x4B: return sharedInstruction<AStoreInstruction, 0>();
+			case 0x4C: return sharedInstruction<AStoreInstruction, 1>();
+			case 0x4D: return sharedInstruction<AStoreInstruction, 2>();
+			case 0x4E: return sharedInstruction<AStoreInstruction, 3>();
+			case 0x4F: return sharedInstruction<IAStoreInstruction>();
+			case 0x50: return sharedInstruction<LAStoreInstruction>();
+			case 0x51: return sharedInstruction<FAStoreInstruction>();
+			case 0x52: return sharedInstruction<DAStoreInstruction>();
+			case 0x53: return sharedInstruction<AAStoreInstruction>();
+			case 0x54: return sharedInstruction<BAStoreInstruction>();
+			case 0x55: return sharedInstruction<CAStoreInstruction>();
+			case 0x56: return sharedInstruction<SAStoreInstruction>();
+			case 0x57: return sharedInstruction<PopInstruction<TypeSize::FOUR_BYTES>>();
+			case 0x58: return sharedInstruction<PopInstruction<TypeSize::EIGHT_BYTES>>();
+			case 0x59: return sharedInstruction<Dup1Instruction>();
+			case 0x5A: return sharedInstruction<DupX1Instruction>();
+			case 0x5B: return sharedInstruction<DupX2Instruction>();
+			case 0x5C: return sharedInstruction<Dup2Instruction>();
+			case 0x5D: return sharedInstruction<Dup2X1Instruction>();
+			case 0x5E: return sharedInstruction<Dup2X2Instruction>();
+			case 0x5F: return sharedInstruction<SwapInstruction>();
+			case 0x60: case 0x61: case 0x62: case 0x63: return sharedOperatorInstruction<AddOperatorInstruction>(current() & 3);
+			case 0x64: case 0x65: case 0x66: case 0x67: return sharedOperatorInstruction<SubOperatorInstruction>(current() & 3);
+			case 0x68: case 0x69: case 0x6A: case 0x6B: return sharedOperatorInstruction<MulOperatorInstruction>(current() & 3);
+			case 0x6C: case 0x6D: case 0x6E: case 0x6F: return sharedOperatorInstruction<DivOperatorInstruction>(current() & 3);
+			case 0x70: case 0x71: case 0x72: case 0x73: return sharedOperatorInstruction<RemOperatorInstruction>(current() & 3);
+			case 0x74: case 0x75: case 0x76: case 0x77: return sharedOperatorInstruction<NegOperatorInstruction>(current() & 3);
+			case 0x78: case 0x79: return sharedOperatorInstruction<ShiftLeftOperatorInstruction>(current() & 1);
+			case 0x7A: case 0x7B: return sharedOperatorInstruction<ShiftRightOperatorInstruction>(current() & 1);
+			case 0x7C: case 0x7D: return sharedOperatorInstruction<UShiftRightOperatorInstruction>(current() & 1);
+			case 0x7E: case 0x7F: return sharedOperatorInstruction<AndOperatorInstruction>(current() & 1);
+			case 0x80: case 0x81: return sharedOperatorInstruction<OrOperatorInstruction>(current() & 1);
+			case 0x82: case 0x83: return sharedOperatorInstruction<XorOperatorInstruction>(current() & 1);
 			case 0x84: return new IIncInstruction(nextUByte(), nextByte()); // UB (depends on the compiler)
-			case 0x85: return new CastInstruction(INT,    LONG,   false); // int -> long
-			case 0x86: return new CastInstruction(INT,    FLOAT,  false); // int -> float
-			case 0x87: return new CastInstruction(INT,    DOUBLE, false); // int -> double
-			case 0x88: return new CastInstruction(LONG,   INT,    true);  // long -> int
-			case 0x89: return new CastInstruction(LONG,   FLOAT,  false); // long -> float
-			case 0x8A: return new CastInstruction(LONG,   DOUBLE, false); // long -> double
-			case 0x8B: return new CastInstruction(FLOAT,  INT,    true);  // float -> int
-			case 0x8C: return new CastInstruction(FLOAT,  LONG,   true);  // float -> long
-			case 0x8D: return new CastInstruction(FLOAT,  DOUBLE, false); // float -> double
-			case 0x8E: return new CastInstruction(DOUBLE, INT,    true);  // double -> int
-			case 0x8F: return new CastInstruction(DOUBLE, LONG,   true);  // double -> long
-			case 0x90: return new CastInstruction(DOUBLE, FLOAT,  true);  // double -> float
-			case 0x91: return new CastInstruction(INT,    BYTE,   true);  // int -> byte
-			case 0x92: return new CastInstruction(INT,    CHAR,   true);  // int -> char
-			case 0x93: return new CastInstruction(INT,    SHORT,  true);  // int -> short
-			case 0x94:            return new LCmpInstruction();
-			case 0x95: case 0x96: return new FCmpInstruction();
-			case 0x97: case 0x98: return new DCmpInstruction();
+			case 0x85: case 0x86: case 0x87: case 0x88: case 0x89: case 0x8A: case 0x8B: case 0x8C:
+			case 0x8D: case 0x8E: case 0x8F: case 0x90: case 0x91: case 0x92: case 0x93:
+				return sharedCastInstruction(current());
+			case 0x94:            return sharedInstruction<LCmpInstruction>();
+			case 0x95: case 0x96: return sharedInstruction<FCmpInstruction>();
+			case 0x97: case 0x98: return sharedInstruction<DCmpInstruction>();
 			case 0x99: return new IfEqInstruction(nextShort());
 			case 0x9A: return new IfNotEqInstruction(nextShort());
 			case 0x9B: return new IfLtInstruction(nextShort());
@@ -175,11 +200,11 @@ namespace jdecompiler {
 				}
 				return new SwitchInstruction(defaultOffset, offsetTable);
 			}
-			case 0xAC: return new IReturnInstruction();
-			case 0xAD: return new LReturnInstruction();
-			case 0xAE: return new FReturnInstruction();
-			case 0xAF: return new DReturnInstruction();
-			case 0xB0: return new AReturnInstruction();
+			case 0xAC: return sharedInstruction<IReturnInstruction>();
+			case 0xAD: return sharedInstruction<LReturnInstruction>();
+			case 0xAE: return sharedInstruction<FReturnInstruction>();
+			case 0xAF: return sharedInstruction<DReturnInstruction>();
+			case 0xB0: return sharedInstruction<AReturnInstruction>();
 			case 0xB1: return VReturn::getInstance();
 			case 0xB2: return new GetStaticFieldInstruction(*this, nextUShort());
 			case 0xB3: return new PutStaticFieldInstruction(*this, nextUShort());
@@ -193,8 +218,8 @@ namespace jdecompiler {
 			case 0xBB: return new NewInstruction(nextUShort());
 			case 0xBC: return new NewArrayInstruction(nextUByte());
 			case 0xBD: return new ANewArrayInstruction(nextUShort());
-			case 0xBE: return new ArrayLengthInstruction();
-			case 0xBF: return new AThrowInstruction();
+			case 0xBE: return sharedInstruction<ArrayLengthInstruction>();
+			case 0xBF: return sharedInstruction<AThrowInstruction>();
 			case 0xC0: return new CheckCastInstruction(nextUShort());
 			case 0xC1: return new InstanceofInstruction(nextUShort());
 			case 0xC2: return nullptr; // TODO: MonitorEnter
@@ -227,10 +252,63 @@ namespace jdecompiler {
 		}
 	}
 
-	const StringifyContext& Method::decompileCode(const ClassInfo& classinfo) {
+	/* Adds this and the arguments of the method to the method scope. The method must have the Code attribute */
+	void Method::addArguments(MethodScope& methodScope, uint32_t codeLength) const {
+		const ClassInfo& classinfo = declaringClassinfo;
+		const bool isNonStatic = !(modifiers & ACC_STATIC);
+		const uint32_t argumentsCount = descriptor.arguments.size();
+
+		if(codeAttribute->attributes.has<LocalVariableTableAttribute>()) {
+			const LocalVariableTableAttribute* localVariableTableAttr = codeAttribute->attributes.get<LocalVariableTableAttribute>();
+
+			using LocalVariable = LocalVariableTableAttribute::LocalVariable;
+
+			for(size_t i = 0, size = localVariableTableAttr->localVariableTable.size(); i < size; i++) {
+				const vector<const LocalVariable*>& localVars = localVariableTableAttr->localVariableTable[i];
+
+				const bool declared = i < (argumentsCount + isNonStatic);
+
+				for(const LocalVariable* localVar : localVars) {
+
+					if(localVar->startPos == 0 && localVar->endPos == codeLength) {
+						methodScope.addVariable(new NamedVariable(&localVar->type, declared, localVar->name));
+						goto ContinueOuter;
+					}
+				}
+				// If no variable found, add empty variable
+				methodScope.addVariable(new UnnamedVariable(i < argumentsCount ? descriptor.arguments[i] : AnyType::getInstance(), declared));
+
+				ContinueOuter:;
+			}
+
+		} else {
+
+			static const ArrayType STRING_ARRAY(STRING);
+
+			if(descriptor.name == "main" && descriptor.returnType == VOID &&
+					(modifiers & ACC_STATIC) && (modifiers & ACC_ACCESS_FLAGS) == ACC_PUBLIC &&
+					argumentsCount == 1 && *descriptor.arguments[0] == STRING_ARRAY) { // public static void main(String[] args)
+				methodScope.addVariable(new NamedVariable(&STRING_ARRAY, true, "args"));
+
+			} else {
+
+				if(isNonStatic)
+					methodScope.addVariable(new NamedVariable(&classinfo.thisType, true, "this"));
+
+				for(uint32_t i = 0; i < argumentsCount; i++)
+					methodScope.addVariable(new UnnamedVariable(descriptor.arguments[i], true));
+			}
+		}
+	}
+
+	const StringifyContext& Method::decompileCode() const {
+		const ClassInfo& classinfo = declaringClassinfo;
 
 		log("decompiling of ", descriptor.toString());
 
+		const Stats::Timer timer(Stats::Phase::DECOMPILATION);
+		Stats::count(Stats::Counter::METHODS);
+
 		const bool hasCodeAttribute = codeAttribute != nullptr;
 		const bool isNonStatic = !(modifiers & ACC_STATIC);
 
@@ -254,63 +332,25 @@ namespace jdecompiler {
 		if(!hasCodeAttribute)
 			return *new StringifyContext(classinfo.getEmptyDisassemblerContext(), classinfo, methodScope, modifiers, descriptor, attributes);
 
+		/* Only the signature is needed, so the code is not disassembled */
+		if(JDecompiler::getInstance().stubsMode()) {
+			addArguments(*methodScope, codeLength);
+			return *new StringifyContext(classinfo.getEmptyDisassemblerContext(), classinfo, methodScope, modifiers, descriptor, attributes);
+		}
+
 		// ------------------------------------------------- Create contexts -------------------------------------------------
 
 		DisassemblerContext& disassemblerContext = *new DisassemblerContext(classinfo.constPool, codeAttribute->codeLength, codeAttribute->code);
 
 		DecompilationContext& decompilationContext =
-				*new DecompilationContext(disassemblerContext, classinfo, methodScope, modifiers, descriptor, attributes, codeAttribute->maxLocals);
+				*new DecompilationContext(disassemblerContext, classinfo, methodScope, modifiers, descriptor, attributes, codeAttribute->maxLocals, codeAttribute->maxStack);
 
 		StringifyContext& stringifyContext = *new StringifyContext(decompilationContext);
 
 		try {
 
 			// -------------------------------------------------- Add arguments --------------------------------------------------
-			{
-				const uint32_t argumentsCount = descriptor.arguments.size();
-
-				if(hasCodeAttribute && codeAttribute->attributes.has<LocalVariableTableAttribute>()) {
-					const LocalVariableTableAttribute* localVariableTableAttr = codeAttribute->attributes.get<LocalVariableTableAttribute>();
-
-					using LocalVariable = LocalVariableTableAttribute::LocalVariable;
-
-					for(size_t i = 0, size = localVariableTableAttr->localVariableTable.size(); i < size; i++) {
-						const vector<const LocalVariable*>& localVars = localVariableTableAttr->localVariableTable[i];
-
-						const bool declared = i < (argumentsCount + isNonStatic);
-
-						for(const LocalVariable* localVar : localVars) {
-
-							if(localVar->startPos == 0 && localVar->endPos == disassemblerContext.length) {
-								methodScope->addVariable(new NamedVariable(&localVar->type, declared, localVar->name));
-								goto ContinueOuter;
-							}
-						}
-						// If no variable found, add empty variable
-						methodScope->addVariable(new UnnamedVariable(i < argumentsCount ? descriptor.arguments[i] : AnyType::getInstance(), declared));
-
-						ContinueOuter:;
-					}
-
-				} else {
-
-					static const ArrayType STRING_ARRAY(STRING);
-
-					if(descriptor.name == "main" && descriptor.returnType == VOID &&
-							(modifiers & ACC_STATIC) && (modifiers & ACC_ACCESS_FLAGS) == ACC_PUBLIC &&
-							argumentsCount == 1 && *descriptor.arguments[0] == STRING_ARRAY) { // public static void main(String[] args)
-						methodScope->addVariable(new NamedVariable(&STRING_ARRAY, true, "args"));
-
-					} else {
-
-						if(isNonStatic)
-							methodScope->addVariable(new NamedVariable(&classinfo.thisType, true, "this"));
-
-						for(uint32_t i = 0; i < argumentsCount; i++)
-							methodScope->addVariable(new UnnamedVariable(descriptor.arguments[i], true));
-					}
-				}
-			}
+			addArguments(*methodScope, codeLength);
 
 			{ // ---------------------------------------------- Add try-catch blocks -----------------------------------------------
 				vector<TryBlock*> tryBlocks;
@@ -353,20 +393,29 @@ namespace jdecompiler {
 				}
 			}
 
-			disassemblerContext.decompile();
+			{
+				const Stats::Timer blocksTimer(Stats::Phase::BLOCKS);
+				disassemblerContext.decompile();
+			}
 
 
 			// ------------------------------------------------- Decompile code --------------------------------------------------
 
 			const vector<Instruction*>& instructions = disassemblerContext.getInstructions();
+			/* Blocks are processed in the order of their start, each one once when its start is reached */
 			vector<const Block*> blocks = disassemblerContext.getBlocks();
+			stable_sort(blocks.begin(), blocks.end(), [] (const Block* block1, const Block* block2) { return block1->start() < block2->start(); });
+
+			size_t nextBlock = 0;
+
+			decompilationContext.exprIndexTable.reserve(instructions.size());
 
 			for(uint32_t i = 0, exprIndex = 0, instructionsSize = instructions.size(); i < instructionsSize; i++) {
 
 				decompilationContext.index = i;
 				decompilationContext.pos = disassemblerContext.indexToPos(i);
 
-				decompilationContext.exprIndexTable[i] = exprIndex;
+				decompilationContext.exprIndexTable.push_back(exprIndex);
 
 				try {
 
@@ -382,6 +431,7 @@ namespace jdecompiler {
 						const Operation* operation = instructions[i]->toOperation(decompilationContext);
 
 						if(operation != nullptr) {
+							Stats::count(Stats::Counter::OPERATIONS);
 
 							if(operation->getReturnType() != VOID) {
 								decompilationContext.stack.push(operation);
@@ -399,12 +449,12 @@ namespace jdecompiler {
 
 					decompilationContext.updateScopes();
 
-					for(auto iter = blocks.begin(); iter != blocks.end(); ) {
-						const Block* block = *iter;
+					for(; nextBlock < blocks.size() && blocks[nextBlock]->start() <= i; nextBlock++) {
+						const Block* block = blocks[nextBlock];
 
 						assert(!(block->start() < i));
 
-						if(block->start() == i) { // Do not increment iterator when erase element
+						if(block->start() == i) {
 
 							const Scope* scope = block->getScope(decompilationContext);
 
@@ -416,11 +466,6 @@ namespace jdecompiler {
 
 								decompilationContext.addScope(scope);
 							}
-
-							blocks.erase(iter);
-
-						} else {
-							++iter;
 						}
 					}
 
@@ -432,20 +477,26 @@ namespace jdecompiler {
 				} catch(const DecompilationException& ex) {
 					errorMessage = ex.toString();
 
-					cerr << "Exception while decompiling method " << descriptor.toString()
+					JDecompiler::getErrorStream() << "Exception while decompiling method " << descriptor.toString()
 							<< " at pos " << decompilationContext.pos
 							<< ", at instruction " << (instructions[i] == nullptr ? "null" : short_typenameof(*instructions[i]))
 							<< ": " << errorMessage << endl;
 
+					ex.printBacktrace(JDecompiler::getErrorStream());
+
 					return stringifyContext;
 				}
 			}
 
-			methodScope->reduceVariableTypes();
+			{
+				const Stats::Timer reduceTimer(Stats::Phase::REDUCE_VARIABLE_TYPES);
+				methodScope->reduceVariableTypes();
+			}
 
 		} catch(const DecompilationException& ex) {
 			errorMessage = ex.toString();
-			cerr << "Exception while decompiling method " << descriptor.toString() << ": " << errorMessage << endl;
+			JDecompiler::getErrorStream() << "Exception while decompiling method " << descriptor.toString() << ": " << errorMessage << endl;
+			ex.printBacktrace(JDecompiler::getErrorStream());
 		}
 
 		return stringifyContext;
@@ -15,10 +15,86 @@ namespace jdecompiler {
 
 		private:
 			vector<Instruction*> instructions;
-			mutable vector<const Block*> blocks, inactiveBlocks;
+			mutable vector<const Block*> blocks;
+			mutable StartIndexQueue<Block> inactiveBlocks;
 			const Block* currentBlock = nullptr;
-			map<pos_t, index_t> indexMap;
-			map<index_t, pos_t> posMap;
+
+			static constexpr index_t NO_INDEX = static_cast<index_t>(-1);
+
+			/* Both tables are filled once and then are only read, so flat arrays are used instead of maps.
+			   indexTable has an entry for each byte of the code, NO_INDEX if no instruction starts at this pos */
+			vector<index_t> indexTable;
+			vector<pos_t> posTable;
+
+			/* Lengths of the instructions by opcode. 0 is for tableswitch, lookupswitch, wide and illegal opcodes */
+			static constexpr uint8_t INSTRUCTION_LENGTHS[256] {
+				1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x00
+				2, 3, 2, 3, 3, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, // 0x10
+				1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x20
+				1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, // 0x30
+				1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x40
+				1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x50
+				1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x60
+				1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x70
+				1, 1, 1, 1, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x80
+				1, 1, 1, 1, 1, 1, 1, 1, 1, 3, 3, 3, 3, 3, 3, 3, // 0x90
+				3, 3, 3, 3, 3, 3, 3, 3, 3, 2, 0, 0, 1, 1, 1, 1, // 0xA0
+				1, 1, 3, 3, 3, 3, 3, 3, 3, 5, 5, 3, 2, 3, 1, 1, // 0xB0
+				3, 3, 1, 1, 0, 4, 3, 3, 5, 5, 0, 0, 0, 0, 0, 0, // 0xC0
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 0xD0
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 0xE0
+				0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0  // 0xF0
+			};
+
+			/* Counts the instructions without decoding them, so the tables are allocated once.
+			   Stops at the first illegal opcode, nextInstruction throws an error on it */
+			index_t countInstructions() const {
+				index_t count = 0;
+
+				for(pos_t p = 0; p < length; count++) {
+					const uint8_t opcode = bytes[p];
+
+					if(INSTRUCTION_LENGTHS[opcode] != 0) {
+						p += INSTRUCTION_LENGTHS[opcode];
+						continue;
+					}
+
+					const auto readInt = [this] (pos_t intPos) -> int64_t {
+						return static_cast<int32_t>(bytes[intPos] << 24 | bytes[intPos + 1] << 16 | bytes[intPos + 2] << 8 | bytes[intPos + 3]);
+					};
+
+					const pos_t operandsPos = p + 4 - (p & 0x3); // alignment by 4 bytes
+					int64_t nextPos;
+
+					switch(opcode) {
+						case 0xAA: // tableswitch
+							if(operandsPos + 12 > length)
+								return count + 1;
+							nextPos = operandsPos + 12 + 4 * (readInt(operandsPos + 8) - readInt(operandsPos + 4) + 1);
+							break;
+
+						case 0xAB: // lookupswitch
+							if(operandsPos + 8 > length)
+								return count + 1;
+							nextPos = operandsPos + 8 + 8 * readInt(operandsPos + 4);
+							break;
+
+						case 0xC4: // wide
+							nextPos = p + (p + 1 < length && bytes[p + 1] == 0x84 ? 6 : 4);
+							break;
+
+						default:
+							return count + 1;
+					}
+
+					if(nextPos <= p)
+						return count + 1;
+
+					p = nextPos > length ? length : static_cast<pos_t>(nextPos);
+				}
+
+				return count;
+			}
 
 		public:
 			DisassemblerContext(const ConstantPool& constPool, uint32_t length, const uint8_t bytes[]):
@@ -27,15 +103,25 @@ namespace jdecompiler {
 				if(length == 0)
 					return;
 
+				const Stats::Timer timer(Stats::Phase::DISASSEMBLY);
+
+				indexTable.assign(length, NO_INDEX);
+
+				const index_t instructionsCount = countInstructions();
+				instructions.reserve(instructionsCount);
+				posTable.reserve(instructionsCount);
+
 				while(available()) {
-					indexMap[pos] = index;
-					posMap[index] = pos;
+					indexTable[pos] = index;
+					posTable.push_back(pos);
 					index++;
 
 					instructions.push_back(nextInstruction());
 
 					next();
 				}
+
+				Stats::count(Stats::Counter::INSTRUCTIONS, instructions.size());
 			}
 
 		protected:
@@ -46,10 +132,9 @@ namespace jdecompiler {
 
 				currentBlock = new RootBlock(size);
 
-				index = 0;
-
-				for(const Instruction* instruction = instructions[0]; index < size; instruction = instructions[++index]) {
-					pos = posMap[index];
+				for(index = 0; index < size; index++) {
+					const Instruction* instruction = instructions[index];
+					pos = posTable[index];
 
 					if(instruction != nullptr) {
 
@@ -91,7 +176,7 @@ namespace jdecompiler {
 
 			inline void addBlock(const Block* block) const {
 				blocks.push_back(block);
-				inactiveBlocks.push_back(block);
+				inactiveBlocks.push(block);
 			}
 
 		protected:
@@ -100,37 +185,32 @@ namespace jdecompiler {
 				while(index >= currentBlock->end()) {
 					if(currentBlock->parentBlock == nullptr)
 						throw DecompilationException("Unexpected end of global function block " + currentBlock->toDebugString());
-					log(index, "  end of ", currentBlock->toDebugString());
+					logtrace(index, "  end of ", currentBlock->toDebugString());
 					currentBlock = currentBlock->parentBlock;
 				}
 
-				for(auto i = inactiveBlocks.begin(); i != inactiveBlocks.end(); ) {
-					const Block* block = *i;
-					if(index >= block->start()) {
-						if(block->end() > currentBlock->end()) {
-							if(block->end() != static_cast<index_t>(-1))
-								throw DecompilationException("Block " + block->toDebugString() +
-										" is out of bounds of the parent block " + currentBlock->toDebugString());
+				inactiveBlocks.popStarted(index, [this] (const Block* block) {
+					if(block->end() > currentBlock->end()) {
+						if(block->end() != static_cast<index_t>(-1))
+							throw DecompilationException("Block " + block->toDebugString() +
+									" is out of bounds of the parent block " + currentBlock->toDebugString());
 
-							block->endIndex = currentBlock->end();
-						}
+						block->endIndex = currentBlock->end();
+					}
 
-						log(index, "start of ", block->toDebugString());
+					logtrace(index, "start of ", block->toDebugString());
 
-						currentBlock->addInnerBlock(block);
-						assert(block != currentBlock);
+					currentBlock->addInnerBlock(block);
+					assert(block != currentBlock);
 
-						if(block->parentBlock == nullptr) {
-							block->parentBlock = currentBlock; // crutch for tryBlocks
-						} else {
-							assert(block->parentBlock == currentBlock);
-						}
+					if(block->parentBlock == nullptr) {
+						block->parentBlock = currentBlock; // crutch for tryBlocks
+					} else {
+						assert(block->parentBlock == currentBlock);
+					}
 
-						currentBlock = block;
-						inactiveBlocks.erase(i);
-					} else
-						++i;
-				}
+					currentBlock = block;
+				});
 			}
 
 			inline uint8_t next() {
@@ -178,17 +258,15 @@ namespace jdecompiler {
 			}
 
 			index_t posToIndex(pos_t pos) const {
-				const auto foundPos = indexMap.find(pos);
-				if(foundPos != indexMap.end())
-					return foundPos->second;
+				if(pos < indexTable.size() && indexTable[pos] != NO_INDEX)
+					return indexTable[pos];
 
 				throw BytecodePosOutOfBoundsException(pos, length);
 			}
 
 			pos_t indexToPos(index_t index) const {
-				const auto foundIndex = posMap.find(index);
-				if(foundIndex != posMap.end())
-					return foundIndex->second;
+				if(index < posTable.size())
+					return posTable[index];
 
 				throw BytecodeIndexOutOfBoundsException(index, length);
 			}
@@ -196,7 +274,7 @@ namespace jdecompiler {
 
 			template<typename... Args>
 			inline void warning(Args... args) const {
-				print(cerr << "Disassembler warning: ", args...);
+				print(JDecompiler::getErrorStream() << "Disassembler warning: ", args...);
 			}
 	};
 }
@@ -8,6 +8,8 @@ namespace jdecompiler {
 	EnumClass::EnumField::EnumField(const Field& field, const vector<const Operation*>& arguments):
 			Field(field), arguments(arguments.begin(), arguments.end() - 2) {}
 
+	EnumClass::EnumField::EnumField(const Field& field): Field(field), arguments() {}
+
 	string EnumClass::EnumField::toString(const StringifyContext& context) const {
 		string str;
 
@@ -22,28 +24,28 @@ namespace jdecompiler {
 	// EnumClass constructor definition moved into function-definitions.cpp
 
 
-	string EnumClass::bodyToString(const ClassInfo& classinfo) const {
-		string str = Class::bodyToString(classinfo);
-		return !str.empty() && enumFields.empty() ? (string)"\n" + classinfo.getIndent() + "/* No enum constants */;\n" + str : str;
-	}
+	void EnumClass::writeBody(OutputWriter& out, const ClassInfo& classinfo) const {
+		const size_t bodyPos = out.size();
 
-	string EnumClass::fieldsToString(const ClassInfo& classinfo) const {
-		string str;
+		Class::writeBody(out, classinfo);
 
+		if(out.size() != bodyPos && enumFields.empty())
+			out.insert(bodyPos, (string)"\n" + classinfo.getIndent() + "/* No enum constants */;\n");
+	}
+
+	void EnumClass::writeFields(OutputWriter& out, const ClassInfo& classinfo) const {
 		if(enumFields.size() > 0)
-			str += (string)"\n" + classinfo.getIndent() +
-					join<const EnumField*>(enumFields, [&classinfo, this] (auto field) { return field->toString(fieldStringifyContext); }) + ";\n";
+			out << '\n' << classinfo.getIndent() <<
+					join<const EnumField*>(enumFields, [&classinfo, this] (auto field) { return field->toString(fieldStringifyContext); }) << ";\n";
 
 		bool anyFieldStringified = false;
 		for(const Field* field : otherFields)
 			if(field->canStringify(classinfo)) {
-				str += '\n' + field->toString(fieldStringifyContext) + ';';
+				out << '\n' << field->toString(fieldStringifyContext) << ';';
 				anyFieldStringified = true;
 			}
 		if(anyFieldStringified)
-			str += '\n';
-
-		return str;
+			out << '\n';
 	}
 }
 
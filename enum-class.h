@@ -12,6 +12,8 @@ namespace jdecompiler {
 
 				EnumField(const Field&, const vector<const Operation*>&);
 
+				EnumField(const Field&);
+
 				virtual string toString(const StringifyContext&) const override;
 			};
 
@@ -24,9 +26,9 @@ namespace jdecompiler {
 
 
 		protected:
-			virtual string bodyToString(const ClassInfo&) const override;
+			virtual void writeBody(OutputWriter&, const ClassInfo&) const override;
 
-			virtual string fieldsToString(const ClassInfo&) const override;
+			virtual void writeFields(OutputWriter&, const ClassInfo&) const override;
 	};
 }
 
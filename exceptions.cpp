@@ -100,6 +100,7 @@ namespace jdecompiler {
 	};
 
 	struct EmptyCodeStackException: DecompilationException {
+		EmptyCodeStackException(): DecompilationException() {}
 		EmptyCodeStackException(const EmptyStackException& ex): DecompilationException(ex.what()) {}
 	};
 
@@ -20,7 +20,7 @@ namespace jdecompiler {
 			throw IllegalModifiersException("Field " + descriptor.toString() + " cannot have enum flag in non-enum class");
 
 	} catch(DecompilationException& ex) {
-		cerr << "Exception while decompiling field " << descriptor.toString() << ": " << ex.toString() << endl;
+		JDecompiler::getErrorStream() << "Exception while decompiling field " << descriptor.toString() << ": " << ex.toString() << endl;
 	}
 
 
@@ -28,6 +28,10 @@ namespace jdecompiler {
 					throw DecompilationException("Enum constant initializer should have at least two arguments, got " +
 							to_string(invokespecialOperation->arguments.size()));
 				enumFields.push_back(new EnumField(*field, invokespecialOperation->arguments));
+
+			} else if(JDecompiler::getInstance().stubsMode() && field->modifiers & ACC_ENUM && field->descriptor.type == thisType) {
+				/* The static initializer is not decompiled in the stubs mode, so arguments of the constants are unknown */
+				enumFields.push_back(new EnumField(*field));
 			} else {
 				otherFields.push_back(field);
 			}
@@ -36,9 +40,9 @@ namespace jdecompiler {
 
 
 	DecompilationContext::DecompilationContext(const DisassemblerContext& disassemblerContext, const ClassInfo& classinfo, MethodScope* methodScope,
-			modifiers_t modifiers, const MethodDescriptor& descriptor, const Attributes& attributes, uint16_t maxLocals):
+			modifiers_t modifiers, const MethodDescriptor& descriptor, const Attributes& attributes, uint16_t maxLocals, uint16_t maxStack):
 			DecompilationAndStringifyContext(disassemblerContext, classinfo, *methodScope, modifiers, descriptor, attributes),
-			stack(*new CodeStack()) {
+			stack(*new CodeStack(maxStack)) {
 
 		for(uint32_t i = methodScope->getVariablesCount(); i < maxLocals; i++)
 			methodScope->addVariable(new UnnamedVariable(AnyType::getInstance(), false));
@@ -50,40 +54,63 @@ namespace jdecompiler {
 			if(currentScope->parentScope == nullptr)
 				throw DecompilationException("Unexpected end of global function scope " + currentScope->toDebugString());
 			currentScope->finalize(*this);
-			log(index, "  end of ", currentScope->toDebugString());
+			logtrace(index, "  end of ", currentScope->toDebugString());
 			currentScope = currentScope->parentScope;
 		}
 
-		for(auto i = inactiveScopes.begin(); i != inactiveScopes.end(); ) {
-			const Scope* scope = *i;
-			if(scope->start() <= index) {
-				/*if(scope->end() > currentScope->end())
-					throw DecompilationException((string)"Scope " + scope->toDebugString() +
-							" is out of bounds of the parent scope " + currentScope->toDebugString());*/
-				/*if(index > scope->start()) {
-					throw IllegalStateException("Scope " + scope->toDebugString() + " is added after it starts");
-				}*/
-
-				log(index, "start of ", scope->toDebugString());
-				currentScope->addOperation(scope, *this);
-				currentScope = scope;
-				//scope->initiate(*this);
-				inactiveScopes.erase(i);
-			} else
-				++i;
-		}
+		inactiveScopes.popStarted(index, [this] (const Scope* scope) {
+			/*if(scope->end() > currentScope->end())
+				throw DecompilationException((string)"Scope " + scope->toDebugString() +
+						" is out of bounds of the parent scope " + currentScope->toDebugString());*/
+			/*if(index > scope->start()) {
+				throw IllegalStateException("Scope " + scope->toDebugString() + " is added after it starts");
+			}*/
+
+			logtrace(index, "start of ", scope->toDebugString());
+			currentScope->addOperation(scope, *this);
+			currentScope = scope;
+			//scope->initiate(*this);
+		});
+	}
+
+
+	const ReferenceType* ConstantPool::getReferenceType(uint16_t classIndex) const {
+		return &getParsed(referenceTypes, classIndex,
+				[this, classIndex] () { return parseReferenceType(get<ClassConstant>(classIndex)->name); });
+	}
+
+	const FieldDescriptor& ConstantPool::getFieldDescriptor(uint16_t fieldrefIndex) const {
+		return getParsed(fieldDescriptors, fieldrefIndex,
+				[this, fieldrefIndex] () { return new FieldDescriptor(get<FieldrefConstant>(fieldrefIndex)->nameAndType); });
+	}
+
+	const MethodDescriptor& ConstantPool::getMethodDescriptor(uint16_t methodrefIndex) const {
+		return getParsed(methodDescriptors, methodrefIndex,
+				[this, methodrefIndex] () { return new MethodDescriptor(get<MethodrefConstant>(methodrefIndex)); });
 	}
 
 
 	string ClassInfo::importsToString() const {
-		string str;
+		vector<string> names;
+		names.reserve(importsByName.size());
+
+		for(const auto& entry : importsByName) {
+			const ClassType* clazz = entry.second;
 
-		for(const ClassType* clazz : imports) {
 			if(clazz->packageName != "java.lang" && clazz->packageName != thisType.packageName) {
-				str += (string)this->getIndent() + "import " + clazz->getName() + ";\n";
+				names.push_back(clazz->getName());
 			}
 		}
 
+		/* The maps are unordered, so the imports are sorted to be the same on every run */
+		sort(names.begin(), names.end());
+
+		string str;
+
+		for(const string& name : names) {
+			str += (string)this->getIndent() + "import " + name + ";\n";
+		}
+
 		return str.empty() ? str : str + '\n';
 	}
 
@@ -93,16 +120,17 @@ namespace jdecompiler {
 			return *clazz == thisType;
 		}
 
-		if(any_of(imports.begin(), imports.end(), [clazz] (const ClassType* imp) { return *clazz == *imp; })) { // find class
+		if(importsByName.find(clazz->getEncodedName()) != importsByName.end()) { // find class
 			return true;
-		} else {
-			if(all_of(imports.begin(), imports.end(), [clazz] (const ClassType* imp)
-					{ return imp->simpleName != clazz->simpleName; })) { // check has no class with same name
-				imports.push_back(clazz);
-				return true;
-			}
+		}
+
+		if(importsBySimpleName.find(clazz->simpleName) != importsBySimpleName.end()) { // other class with same name is imported
 			return false;
 		}
+
+		importsByName[clazz->getEncodedName()] = clazz;
+		importsBySimpleName[clazz->simpleName] = clazz;
+		return true;
 	}
 
 	string ClassType::toString(const ClassInfo& classinfo) const {
@@ -110,18 +138,135 @@ namespace jdecompiler {
 				'<' + join<const ReferenceType*>(parameters, [&classinfo] (const ReferenceType* type) { return type->toString(classinfo); }) + '>');
 	}
 
+	void JDecompiler::collectClassSources() const {
+		static const regex
+				classExtension("\\.class$"),
+				archiveExtension("\\.(jar|zip|war)$", regex::icase);
+
+		for(ClassInputStream* file : files)
+			classSources.push_back(new ClassSource(file));
+
+		/* Classes from the archive are placed into the directory with the name of the archive,
+		   so the entries which would be written outside of it are skipped */
+		for(const ZipArchive* archive : archives) {
+			for(const ZipArchive::Entry& entry : archive->getEntries()) {
+				if(regex_search(entry.name, classExtension)) {
+					if(entry.hasSafeName())
+						classSources.push_back(new ClassSource(archive, &entry, regex_replace(archive->path, archiveExtension, "") + '/' + entry.name));
+					else
+						error(archive->path, ": invalid entry name ", entry.name);
+				}
+			}
+		}
+	}
+
+	/* The stream is closed after reading, classes keep copies of the data they refer to */
+	const Class* JDecompiler::readClassSource(ClassSource& source) const {
+		call_once(source.readFlag, [this, &source] () {
+			const Stats::Timer timer(Stats::Phase::READ);
+
+			const ClassSource* const previousReadingSource = readingSource;
+			readingSource = &source;
+
+			try {
+				source.clazz = Class::readClass(source.open());
+				Stats::count(Stats::Counter::CLASSES);
+			} catch(const EOFException& ex) {
+				error("unexpected end of file while reading ", source.fileName);
+			} catch(const Exception& ex) {
+				error(ex.toString());
+				ex.printBacktrace(getErrorStream());
+			}
+
+			readingSource = previousReadingSource;
+
+			source.close();
+		});
+
+		return source.clazz;
+	}
+
+	void JDecompiler::registerClass(const ClassSource& source) const {
+		static const regex classExtension("\\.class$");
+
+		const string name = source.clazz->thisType.getEncodedName();
+
+		const lock_guard<recursive_mutex> lock(classesMutex);
+
+		classes[name] = source.clazz;
+		decompilationClasses.emplace(name, ClassHolder(regex_replace(source.fileName, classExtension, "") + ".java", source.clazz));
+	}
+
+	const Class* JDecompiler::loadClassSource(ClassSource& source) const {
+		const Class* clazz = readClassSource(source);
+
+		if(clazz != nullptr)
+			registerClass(source);
+
+		return clazz;
+	}
+
 	void JDecompiler::readClassFiles() const {
 		if(atLeastOneFileSpecified) {
-			for(ClassInputStream* classFile : files) {
-				try {
-					Class::readClass(*classFile); /* Adding a class to JDecompiler::classes takes place in the class constructor */
-				} catch(const EOFException& ex) {
-					error("unexpected end of file while reading ", classFile->fileName);
-				} catch(const Exception& ex) {
-					error(ex.toString());
-				}
+			collectClassSources();
+			indexClassSources();
+
+			parallelFor(classSources.size(), jobs, [this] (size_t i) { readClassSource(*classSources[i]); });
+
+			/* Classes are added in the order of the files, so the result does not depend on the number of jobs */
+			for(const ClassSource* source : classSources)
+				if(source->clazz != nullptr)
+					registerClass(*source);
+
+		} else {
+			error("no input file specified");
+		}
+	}
+
+	void JDecompiler::indexClassSources() const {
+		vector<string> names(classSources.size());
+
+		/* Entries of archives are inflated in the same threads which read their names.
+		   Archive entries can be placed under a prefix (WEB-INF/classes/, META-INF/versions/<n>/),
+		   so their names are read from the class too */
+		parallelFor(classSources.size(), jobs, [this, &names] (size_t i) {
+			ClassSource* const source = classSources[i];
+
+			try {
+				names[i] = Class::readName(source->open());
+			} catch(const Exception&) {
+				// The error is reported when the class is read
 			}
 
+			/* In the stream mode, the inflated entry is freed until the class is read */
+			if(source->archive != nullptr && streamWindow != 0)
+				source->close();
+		});
+
+		vector<ClassSource*> indexedSources;
+		indexedSources.reserve(classSources.size());
+
+		for(size_t i = 0, size = classSources.size(); i < size; i++) {
+			ClassSource* const source = classSources[i];
+			const string& name = names[i];
+
+			if(name.empty() || sourcesByName.emplace('L' + name + ';', source).second) {
+				source->index = indexedSources.size();
+				indexedSources.push_back(source);
+			} else {
+				error(source->fileName, ": duplicate class ", name, ", it is already defined in ", sourcesByName['L' + name + ';']->fileName);
+				source->close();
+				delete source;
+			}
+		}
+
+		classSources = indexedSources;
+	}
+
+	void JDecompiler::indexClassFiles() const {
+		if(atLeastOneFileSpecified) {
+			collectClassSources();
+			indexClassSources();
 		} else {
 			error("no input file specified");
 		}
@@ -138,9 +283,13 @@ namespace jdecompiler {
 		currentScope = scope->parentScope;
 	}
 
+	/* The context outlives the code arenas of the class, so it is allocated on the heap */
 	const DisassemblerContext& ClassInfo::getEmptyDisassemblerContext() const {
-		if(emptyDisassemblerContext == nullptr)
+		call_once(emptyDisassemblerContextFlag, [this] () {
+			const Arena::Guard heapGuard(nullptr);
 			emptyDisassemblerContext = new DisassemblerContext(constPool, 0, (const uint8_t*)"");
+		});
+
 		return *emptyDisassemblerContext;
 	}
 }
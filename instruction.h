@@ -3,9 +3,9 @@
 
 namespace jdecompiler {
 
-	struct Instruction {
+	struct Instruction: ArenaObject {
 		protected:
-			explicit constexpr Instruction() noexcept {}
+			explicit Instruction() noexcept {}
 
 		public:
 			virtual ~Instruction() {}
@@ -5,7 +5,7 @@ namespace jdecompiler {
 
 	struct AConstNull final: InstructionAndOperation {
 		private:
-			constexpr AConstNull() noexcept {}
+			AConstNull() noexcept {}
 
 		public:
 			virtual string toString(const StringifyContext&) const override {
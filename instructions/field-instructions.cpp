@@ -11,7 +11,7 @@ namespace jdecompiler {
 			clazz(fieldref->clazz), descriptor(fieldref->nameAndType) {}
 
 		FieldInstruction(const DisassemblerContext& context, uint16_t index):
-			FieldInstruction(context.constPool.get<FieldrefConstant>(index)) {}
+			clazz(*ClassType::getInstance(context.constPool.get<FieldrefConstant>(index)->clazz)), descriptor(context.constPool.getFieldDescriptor(index)) {}
 	};
 
 
@@ -6,7 +6,7 @@ namespace jdecompiler {
 		const MethodDescriptor& descriptor;
 
 		InvokeInstruction(uint16_t index, const ConstantPool& constPool):
-				InstructionWithIndex(index), descriptor(*new MethodDescriptor(constPool.get<MethodrefConstant>(index))) {}
+				InstructionWithIndex(index), descriptor(constPool.getMethodDescriptor(index)) {}
 	};
 
 
@@ -127,10 +127,10 @@ namespace jdecompiler {
 
 					vector<const Operation*> arguments(descriptor.arguments.size());
 
-					static const ArrayType OBJECT_ARRAY(OBJECT);
-					static const ClassType CALL_SITE("java/lang/invoke/CallSite");
-					static const ClassType LOOKUP("java/lang/invoke/MethodHandles$Lookup");
-					static const ClassType STRING_CONCAT_FACTORY("java/lang/invoke/StringConcatFactory");
+					static const ArrayType& OBJECT_ARRAY = *ArrayType::getInstance(OBJECT);
+					static const ClassType& CALL_SITE = *ClassType::getInstance("java/lang/invoke/CallSite");
+					static const ClassType& LOOKUP = *ClassType::getInstance("java/lang/invoke/MethodHandles$Lookup");
+					static const ClassType& STRING_CONCAT_FACTORY = *ClassType::getInstance("java/lang/invoke/StringConcatFactory");
 
 					// pop arguments that already on stack
 					for(uint32_t i = descriptor.arguments.size(); i > 0; )
@@ -23,7 +23,7 @@ namespace jdecompiler {
 			const ArrayType *const arrayType;
 
 		public:
-			NewArrayInstruction(uint8_t code): arrayType(new ArrayType(getArrayTypeByCode(code))) {}
+			NewArrayInstruction(uint8_t code): arrayType(ArrayType::getInstance(getArrayTypeByCode(code))) {}
 
 			virtual const Operation* toOperation(const DecompilationContext& context) const override {
 				return new NewArrayOperation(context, arrayType);
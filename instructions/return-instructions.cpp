@@ -18,7 +18,7 @@ namespace jdecompiler {
 
 	struct VReturn: VoidInstructionAndOperation {
 		private:
-			constexpr VReturn() noexcept {}
+			VReturn() noexcept {}
 
 		public:
 			virtual string toString(const StringifyContext&) const override { return "return"; }
@@ -5,7 +5,7 @@ namespace jdecompiler {
 
 	struct SwapInstruction: Instruction {
 		virtual const Operation* toOperation(const DecompilationContext& context) const override {
-			context.stack.push(context.stack.pop(), context.stack.pop());
+			context.stack.swap();
 			return nullptr;
 		}
 	};
@@ -5,15 +5,15 @@ namespace jdecompiler {
 
 	namespace javaLang {
 		static inline const ClassType
-				Void("java/lang/Void"),
-				Byte("java/lang/Byte"),
-				Character("java/lang/Character"),
-				Short("java/lang/Short"),
-				Integer("java/lang/Integer"),
-				Long("java/lang/Long"),
-				Float("java/lang/Float"),
-				Double("java/lang/Double"),
-				Boolean("java/lang/Boolean"),
+				&Void = *ClassType::getInstance("java/lang/Void"),
+				&Byte = *ClassType::getInstance("java/lang/Byte"),
+				&Character = *ClassType::getInstance("java/lang/Character"),
+				&Short = *ClassType::getInstance("java/lang/Short"),
+				&Integer = *ClassType::getInstance("java/lang/Integer"),
+				&Long = *ClassType::getInstance("java/lang/Long"),
+				&Float = *ClassType::getInstance("java/lang/Float"),
+				&Double = *ClassType::getInstance("java/lang/Double"),
+				&Boolean = *ClassType::getInstance("java/lang/Boolean"),
 
 				&Object = *OBJECT,
 				&String = *STRING,
@@ -26,7 +26,7 @@ namespace jdecompiler {
 	}
 
 	namespace javaLangAnnotation {
-		static inline const ClassType Annotation("java/lang/annotation/Annotation");
+		static inline const ClassType& Annotation = *ClassType::getInstance("java/lang/annotation/Annotation");
 	}
 }
 
@@ -15,6 +15,9 @@
 #include <unordered_map>
 #include <tuple>
 #include <iostream>
+#include <thread>
+#include <mutex>
+#include <atomic>
 #include "util/restrict.h"
 
 namespace util {}
@@ -48,6 +51,14 @@ namespace jdecompiler {
 	using std::invalid_argument;
 	using std::out_of_range;
 
+	using std::thread;
+	using std::atomic;
+	using std::mutex;
+	using std::recursive_mutex;
+	using std::lock_guard;
+	using std::once_flag;
+	using std::call_once;
+
 	using std::function;
 
 	using std::ostringstream;
@@ -2,10 +2,13 @@
 #define JDECOMPILER_JDECOMPILER_INSTANCE_CPP
 
 #include <filesystem>
+#include <regex>
 #include <dlfcn.h>
 #include "util.h"
 #include "jvm.h"
 #include "class-holder.cpp"
+#include "class-source.cpp"
+#include "stats.cpp"
 
 #ifndef JDECOMPILER_VERSION
 #define JDECOMPILER_VERSION "unknown"
@@ -25,6 +28,9 @@ namespace jdecompiler {
 
 	namespace filesystem = std::filesystem;
 
+	using std::regex;
+	using std::regex_search;
+
 
 	struct JDecompiler {
 
@@ -32,6 +38,7 @@ namespace jdecompiler {
 			static const JDecompiler* instance;
 
 			vector<ClassInputStream*> files;
+			vector<const ZipArchive*> archives;
 
 			string progName;
 
@@ -64,8 +71,35 @@ namespace jdecompiler {
 			bool canPrintNewLineInParameterAnnotations = true;
 			bool canOmitBrackets = true;
 
+			bool isStubsMode = false;
+
+			uint32_t jobs = 1;
+			uint32_t streamWindow = 0;
+
+			static constexpr uint32_t DEFAULT_STREAM_WINDOW = 16;
+
+			mutable vector<ClassSource*> classSources;
+
+			/* The sources of all input classes by their names, which are known before the classes are read.
+			   A class is read when it is needed for the first time */
+			mutable umap<string, ClassSource*> sourcesByName;
+
 			mutable umap<string, ClassHolder> decompilationClasses;
 			mutable umap<string, const Class*> classes;
+			mutable recursive_mutex classesMutex;
+
+			/* The class which is being read by the current thread. It is visible through getClass
+			   before it is added to the classes map */
+			static thread_local const ClassType* readingClassType;
+			static thread_local const Class* readingClass;
+
+			/* The input class which is being read by the current thread and whether the thread loads a class from the jvm */
+			static thread_local const ClassSource* readingSource;
+			static thread_local bool loadingFromJvm;
+
+			/* Errors and warnings of the class which is being written by the current thread are printed into its stream.
+			   In the multithreaded mode each class has its own buffer, so the messages are in the same order as with one thread */
+			static thread_local ostream* errorStream;
 
 			friend struct Class;
 
@@ -141,7 +175,7 @@ namespace jdecompiler {
 
 
 				if(argc <= 1) {
-					cout << "Usage: " << progName << " [options] <class-files>" << endl;
+					cout << "Usage: " << progName << " [options] <class-files|jar-files>" << endl;
 					initSuccess = false;
 					return;
 				}
@@ -157,7 +191,9 @@ namespace jdecompiler {
 					if(!hasValue) {\
 						printErrorAndExit("option " << option << " required value");\
 					}\
-					i++;\
+					if(!hasValueWeak) {\
+						i++;\
+					}\
 				}
 
 				bool atLeastOneFileSpecified = false;
@@ -186,7 +222,7 @@ namespace jdecompiler {
 
 
 						if(option == "-h" || option == "--help" || option == "-?") {
-							cout << "Usage: " << progName << " [options] <class-files>\n"
+							cout << "Usage: " << progName << " [options] <class-files|jar-files>\n"
 							"\n"
 							"----------------------------------------------- Options ------------------------------------------------\n"
 							"General:\n"
@@ -194,6 +230,16 @@ namespace jdecompiler {
 							"  -v, --version                         show program version\n"
 							//"  -d, --dir=<directory>                 specify directory to place decompiled files\n"
 							"  --java-home=<path/to/java>            specify the java home path (if JAVA_HOME env var is not set)\n"
+							"  -j, --jobs=<count>                    read, decompile and stringify classes in <count> threads\n"
+							"  -s, --stream[=<count>]                read, decompile and write classes by groups of <count> (16 by default)\n"
+							"                                        and release each group after it is written\n"
+							"  --stubs                               print only declarations of classes, fields and methods\n"
+							"                                        with { throw null; } instead of method bodies\n"
+							"  --log=<off|error|debug|trace>         print log messages of the level and all lower levels to stderr\n"
+							"  --stats[=text|json]                   print the time of each phase summed over all threads, the wall time\n"
+							"                                        and the number of decompiled classes, methods, instructions,\n"
+							"                                        operations and scopes to stderr\n"
+							"  --debug-backtraces                    capture backtraces of exceptions and print them with the errors\n"
 							"\n"
 							"Decompilation of constants:\n"
 							"  -c, --use-constants[=auto|min|never]  use constants:\n"
@@ -244,6 +290,57 @@ namespace jdecompiler {
 							requireValue();
 							javaHome = strdup(value.c_str());
 
+						} else if(option == "-j" || option == "--jobs") {
+							requireValue();
+
+							char* end;
+							const unsigned long count = strtoul(value.c_str(), &end, 10);
+
+							if(*end != '\0' || count == 0 || count > UINT16_MAX)
+								printErrorAndExit("invalid value for option " << option << ": expected positive number");
+
+							jobs = count;
+
+						} else if(option == "-s" || option == "--stream") {
+							if(hasValueWeak) {
+								char* end;
+								const unsigned long count = strtoul(value.c_str(), &end, 10);
+
+								if(*end != '\0' || count == 0 || count > UINT16_MAX)
+									printErrorAndExit("invalid value for option " << option << ": expected positive number");
+
+								streamWindow = count;
+							} else {
+								streamWindow = DEFAULT_STREAM_WINDOW;
+							}
+
+						} else if(option == "--log") {
+							requireValue();
+
+							if(value == "off")        logLevel = JDECOMPILER_LOG_OFF;
+							else if(value == "error") logLevel = JDECOMPILER_LOG_ERROR;
+							else if(value == "debug") logLevel = JDECOMPILER_LOG_DEBUG;
+							else if(value == "trace") logLevel = JDECOMPILER_LOG_TRACE;
+							else printErrorAndExit("invalid value for option " << option << ": only valid off, error, debug or trace");
+
+							if(logLevel > JDECOMPILER_LOG_LEVEL)
+								cerr << progName << ": warning: log level " << value << " is disabled at compile time" << endl;
+
+						} else if(option == "--stats") {
+							if(hasValueWeak) {
+								if(value == "text")      Stats::enable(Stats::Format::TEXT);
+								else if(value == "json") Stats::enable(Stats::Format::JSON);
+								else printErrorAndExit("invalid value for option " << option << ": only valid text or json");
+							} else {
+								Stats::enable(Stats::Format::TEXT);
+							}
+
+						} else if(option == "--debug-backtraces") {
+							Exception::captureBacktraces = true;
+
+						} else if(option == "--stubs") {
+							isStubsMode = true;
+
 						} else if(option == "-o-") {
 							canWriteToConsole = true;
 
@@ -338,8 +435,13 @@ namespace jdecompiler {
 						}
 					} else {
 						atLeastOneFileSpecified = true;
+						static const regex archiveExtension("\\.(jar|zip|war)$", regex::icase);
+
 						try {
-							files.push_back(new ClassInputStream(*new FileBinaryInputStream(arg)));
+							if(regex_search(arg, archiveExtension))
+								archives.push_back(new ZipArchive(arg));
+							else
+								files.push_back(new ClassInputStream(arg));
 						} catch(const IOException& ex) {
 							printError(ex.toString());
 						}
@@ -471,13 +573,50 @@ namespace jdecompiler {
 				return canOmitBrackets;
 			}
 
+			inline bool stubsMode() const {
+				return isStubsMode;
+			}
+
+			inline uint32_t getJobs() const {
+				return jobs;
+			}
+
+			inline uint32_t getStreamWindow() const {
+				return streamWindow;
+			}
+
 
 			inline const vector<ClassInputStream*>& getFiles() const {
 				return files;
 			}
 
+			inline const vector<const ZipArchive*>& getArchives() const {
+				return archives;
+			}
+
 			void readClassFiles() const;
 
+		private:
+			void collectClassSources() const;
+
+			void indexClassSources() const;
+
+			void registerClass(const ClassSource&) const;
+
+		public:
+			/* Builds the index of classes without reading them, for the stream mode */
+			void indexClassFiles() const;
+
+			/* Reads the class once, returns nullptr if it cannot be read */
+			const Class* readClassSource(ClassSource&) const;
+
+			/* Reads the class once and makes it visible through getClass */
+			const Class* loadClassSource(ClassSource&) const;
+
+			inline const vector<ClassSource*>& getClassSources() const {
+				return classSources;
+			}
+
 			inline const umap<string, ClassHolder>& getDecompilationClasses() const {
 				return decompilationClasses;
 			}
@@ -486,11 +625,7 @@ namespace jdecompiler {
 				return classes;
 			}
 
-			inline const Class* getClass(const string& name) const {
-				const auto& classIterator = classes.find(name);
-				return classIterator != classes.end() ? classIterator->second :
-						classes[name] = (jvm != nullptr ? jvm->loadClass(name.c_str()) : nullptr);
-			}
+			const Class* getClass(const string& name) const;
 
 			const ClassInfo* getClassInfo(const string& name) const;
 
@@ -498,6 +633,12 @@ namespace jdecompiler {
 				return getClass(name) != nullptr;
 			}
 
+			/* Unlike getClass, does not read the class in the stream mode and does not load it from the jvm */
+			const Class* findLoadedClass(const string& name) const;
+
+			/* Returns true if the class is given in the input files, even if it has not been read yet */
+			bool hasInputClass(const string& name) const;
+
 		protected:
 			template<typename Arg, typename... Args>
 			static inline void print(ostream& out, Arg arg, Args... args) {
@@ -507,10 +648,33 @@ namespace jdecompiler {
 					out << arg << endl;
 			}
 
+		public:
+			static inline ostream& getErrorStream() {
+				return *errorStream;
+			}
+
+			/* Makes the stream the error stream of this thread while the guard exists */
+			struct ErrorStreamGuard {
+				private:
+					ostream* const previous;
+
+				public:
+					explicit ErrorStreamGuard(ostream& stream) noexcept: previous(errorStream) {
+						errorStream = &stream;
+					}
+
+					ErrorStreamGuard(const ErrorStreamGuard&) = delete;
+					ErrorStreamGuard& operator=(const ErrorStreamGuard&) = delete;
+
+					~ErrorStreamGuard() {
+						errorStream = previous;
+					}
+			};
+
 		private:
 			template<typename... Args>
 			inline void error(Args... args) const {
-				print(cerr << progName << ": error: ", args...);
+				print(getErrorStream() << progName << ": error: ", args...);
 			}
 	};
 
@@ -519,6 +683,11 @@ namespace jdecompiler {
 	void *JDecompiler::libJvm = nullptr,
 	     *JDecompiler::systemLibJvm = nullptr;
 	bool JDecompiler::initSuccess = true;
+	thread_local const ClassType* JDecompiler::readingClassType = nullptr;
+	thread_local const Class* JDecompiler::readingClass = nullptr;
+	thread_local const ClassSource* JDecompiler::readingSource = nullptr;
+	thread_local bool JDecompiler::loadingFromJvm = false;
+	thread_local ostream* JDecompiler::errorStream = &cerr;
 }
 
 #endif
@@ -9,28 +9,72 @@
 
 namespace jdecompiler {
 
-	using std::cout;
-	using std::endl;
-
 	struct JVMImpl: JVM {
 
 		public:
 			JavaVM* const vm;
-			JNIEnv* const env;
-			const jclass class_Class, class_System;
 
+		private:
+			/* Local references and JNIEnv are valid only in the thread where they were got,
+			   so the classes are kept as global references and each thread gets its own JNIEnv */
+			const jclass class_Class, class_System, class_PrintStream, class_NoClassDefFoundError;
+			const jmethodID method_getDeclaredMethods, method_println;
+			const jobject out;
+
+			/* Detaches a worker thread from the vm when the thread exits */
+			struct AttachedThread {
+				JavaVM* vm = nullptr;
+
+				~AttachedThread() {
+					if(vm != nullptr)
+						vm->DetachCurrentThread();
+				}
+			};
+
+			static jclass findClass(JNIEnv* env, const char* name) {
+				jclass localClass = env->FindClass(name);
+				jclass globalClass = static_cast<jclass>(env->NewGlobalRef(localClass));
+				env->DeleteLocalRef(localClass);
+				return globalClass;
+			}
+
+			static jobject getOut(JNIEnv* env, jclass class_System) {
+				jobject localOut = env->GetStaticObjectField(class_System, env->GetStaticFieldID(class_System, "out", "Ljava/io/PrintStream;"));
+				jobject globalOut = env->NewGlobalRef(localOut);
+				env->DeleteLocalRef(localOut);
+				return globalOut;
+			}
+
+			JNIEnv* getEnv() const {
+				JNIEnv* env;
+
+				if(vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_10) == JNI_OK)
+					return env;
+
+				static thread_local AttachedThread attachedThread;
+
+				if(vm->AttachCurrentThreadAsDaemon(reinterpret_cast<void**>(&env), nullptr) != JNI_OK)
+					return nullptr;
+
+				attachedThread.vm = vm;
+				return env;
+			}
+
+		public:
 			JVMImpl(JavaVM* vm, JNIEnv* env):
-					vm(vm), env(env), class_Class(env->FindClass("java/lang/Class")), class_System(env->FindClass("java/lang/System")) {}
+					vm(vm),
+					class_Class(findClass(env, "java/lang/Class")),
+					class_System(findClass(env, "java/lang/System")),
+					class_PrintStream(findClass(env, "java/io/PrintStream")),
+					class_NoClassDefFoundError(findClass(env, "java/lang/NoClassDefFoundError")),
+					method_getDeclaredMethods(env->GetMethodID(class_Class, "getDeclaredMethods", "()[Ljava/lang/reflect/Method;")),
+					method_println(env->GetMethodID(class_PrintStream, "println", "(Ljava/lang/Object;)V")),
+					out(getOut(env, class_System)) {}
 
 			JVMImpl(const JVMImpl&) = delete;
 
 		private:
-			void println(jobject obj) const {
-				static jclass class_PrintStream = env->FindClass("java/io/PrintStream");
-				static jmethodID method_println = env->GetMethodID(class_PrintStream, "println", "(Ljava/lang/Object;)V");
-				static jfieldID field_out = env->GetStaticFieldID(class_System, "out", "Ljava/io/PrintStream;");
-				static jobject out = env->GetStaticObjectField(class_System, field_out);
-
+			void println(JNIEnv* env, jobject obj) const {
 				env->CallVoidMethod(out, method_println, obj);
 				env->ExceptionDescribe();
 			}
@@ -38,8 +82,10 @@ namespace jdecompiler {
 		public:
 			virtual const Class* loadClass(const char* name) const override {
 
-				static const jclass class_NoClassDefFoundError = env->FindClass("java/lang/NoClassDefFoundError");
-				static const jmethodID method_getDeclaredMethods = env->GetMethodID(class_Class, "getDeclaredMethods", "()[Ljava/lang/reflect/Method;");
+				JNIEnv* env = getEnv();
+
+				if(env == nullptr)
+					return nullptr;
 
 				jclass clazz = env->FindClass(name/*"example/ExampleClass"*/);
 
@@ -50,8 +96,6 @@ namespace jdecompiler {
 
 				env->ExceptionDescribe();
 
-				cout << "loadClass " << name << ' ' << clazz << endl;
-
 				if(clazz == nullptr)
 					return nullptr;
 
@@ -62,11 +106,16 @@ namespace jdecompiler {
 				for(jsize i = 0; i < length; i++) {
 					jobject method = env->GetObjectArrayElement(methods, i);
 
-					println(method);
+					println(env, method);
+
+					env->DeleteLocalRef(method);
 				}
 
 				env->ExceptionDescribe();
 
+				env->DeleteLocalRef(methods);
+				env->DeleteLocalRef(clazz);
+
 				return nullptr;
 			}
 
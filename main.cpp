@@ -4,6 +4,121 @@
 #include "function-definitions.cpp"
 #include "finish.cpp"
 
+namespace jdecompiler {
+
+	/* Stringifies the class and writes it into the output file.
+	   Returns the source of the class if it should be written to the console */
+	static string writeClass(const string& name, const ClassHolder& clazz, ostream& errout) {
+		log("stringify of", name);
+
+		/* Everything created while stringifying belongs to the class and is destroyed after it is written */
+		const Arena::Guard arenaGuard(clazz->getArena());
+
+		/* Errors of the methods, which are decompiled while stringifying, are written with the errors of the class */
+		const JDecompiler::ErrorStreamGuard errorStreamGuard(errout);
+
+		string result;
+
+		try {
+			OutputWriter out;
+
+			{
+				const Stats::Timer timer(Stats::Phase::STRINGIFY);
+				clazz->writeTo(out);
+			}
+
+			if(JDecompiler::getInstance().writeToConsole()) {
+				result = out.release();
+
+			} else {
+				const Stats::Timer timer(Stats::Phase::WRITE);
+
+				createParentDirectories(clazz.outputPath);
+
+				BinaryOutputStream* outfile = new FileBinaryOutputStream(clazz.outputPath);
+				outfile->writeString(out.str());
+				delete outfile;
+			}
+
+		} catch(const Exception& ex) {
+			errout << "Exception while decompiling class " << clazz->thisType.getClassEncodedName() << ": " << ex.toString() << endl;
+			ex.printBacktrace(errout);
+		} catch(const exception& ex) {
+			const char* errorMessage = ex.what();
+			errout << "Exception while decompiling class " << clazz->thisType.getClassEncodedName() << ": " <<
+					typenameof(ex) << (*errorMessage == '\0' ? "" : ": ") << errorMessage << endl;
+		}
+
+		clazz->releaseCode();
+
+		return result;
+	}
+
+
+	/* Writes the classes in up to jobs threads and prints the results in the order of the classes */
+	static void writeClasses(const vector<pair<string, ClassHolder>>& classes, uint32_t jobs) {
+		const bool writeToConsole = JDecompiler::getInstance().writeToConsole();
+
+		if(jobs <= 1) {
+			for(const auto& nameAndClass : classes) {
+				const string result = writeClass(nameAndClass.first, nameAndClass.second, cerr);
+
+				if(writeToConsole && !result.empty())
+					cout << result << endl;
+			}
+
+			return;
+		}
+
+		vector<string> results(classes.size()), errors(classes.size());
+
+		parallelFor(classes.size(), jobs, [&classes, &results, &errors] (size_t i) {
+			ostringstream errout;
+			results[i] = writeClass(classes[i].first, classes[i].second, errout);
+			errors[i] = errout.str();
+		});
+
+		/* Print the results in the same order as in the single-threaded mode */
+		for(size_t i = 0, size = classes.size(); i < size; i++) {
+			cerr << errors[i];
+
+			if(writeToConsole && !results[i].empty())
+				cout << results[i] << endl;
+		}
+	}
+
+
+	/* Reads, writes and releases the classes by groups, so only a few classes are decompiled at the same time.
+	   Classes from the other groups are read when they are needed by getClass */
+	static void streamClasses(const JDecompiler& jdecompiler) {
+		jdecompiler.indexClassFiles();
+
+		const vector<ClassSource*>& sources = jdecompiler.getClassSources();
+		const size_t window = jdecompiler.getStreamWindow();
+
+		for(size_t start = 0, size = sources.size(); start < size; start += window) {
+			const size_t end = min(start + window, size);
+
+			parallelFor(end - start, jdecompiler.getJobs(), [&jdecompiler, &sources, start] (size_t i) {
+				jdecompiler.loadClassSource(*sources[start + i]);
+			});
+
+			vector<pair<string, ClassHolder>> stringifiedClasses;
+
+			for(size_t i = start; i < end; i++) {
+				const Class* clazz = jdecompiler.loadClassSource(*sources[i]);
+
+				if(clazz != nullptr && clazz->canStringify()) {
+					const string name = clazz->thisType.getEncodedName();
+					stringifiedClasses.emplace_back(name, jdecompiler.getDecompilationClasses().at(name));
+				}
+			}
+
+			writeClasses(stringifiedClasses, jdecompiler.getJobs());
+		}
+	}
+}
+
 int main(int argc, const char* args[]) {
 	using namespace jdecompiler;
 	using std::boolalpha;
@@ -17,34 +132,25 @@ int main(int argc, const char* args[]) {
 	if(!JDecompiler::init(argc, args))
 		return 0;
 
-	JDecompiler::getInstance().readClassFiles();
+	const JDecompiler& jdecompiler = JDecompiler::getInstance();
 
-	for(const auto& nameAndClass : JDecompiler::getInstance().getDecompilationClasses()) {
-		const ClassHolder& clazz = nameAndClass.second;
+	if(jdecompiler.getStreamWindow() != 0) {
+		streamClasses(jdecompiler);
 
-		if(clazz->canStringify()) {
-			log("stringify of", nameAndClass.first);
+	} else {
+		jdecompiler.readClassFiles();
 
-			try {
-				if(JDecompiler::getInstance().writeToConsole()) {
-					cout << clazz->toString() << endl;
+		vector<pair<string, ClassHolder>> stringifiedClasses;
 
-				} else {
-					BinaryOutputStream* outfile = new FileBinaryOutputStream(clazz.outputPath);
-					outfile->writeString(clazz->toString());
-					delete outfile;
-				}
+		for(const auto& nameAndClass : jdecompiler.getDecompilationClasses())
+			if(nameAndClass.second->canStringify())
+				stringifiedClasses.emplace_back(nameAndClass.first, nameAndClass.second);
 
-			} catch(const Exception& ex) {
-				cerr << "Exception while decompiling class " << nameAndClass.second->thisType.getClassEncodedName() << ": " << ex.toString() << endl;
-			} catch(const exception& ex) {
-				const char* errorMessage = ex.what();
-				cerr << "Exception while decompiling class " << nameAndClass.second->thisType.getClassEncodedName() << ": " <<
-						typenameof(ex) << (*errorMessage == '\0' ? "" : ": ") << errorMessage << endl;
-			}
-		}
+		writeClasses(stringifiedClasses, jdecompiler.getJobs());
 	}
 
+	Stats::print(cerr, JDECOMPILER_VERSION);
+
 	return 0;
 }
 
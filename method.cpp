@@ -80,23 +80,24 @@ namespace jdecompiler {
 			});
 		};
 
+		/* getScope() decompiles the method, so it is checked last */
 		return (descriptor == MethodDescriptor(classinfo.thisType, "<init>", VOID, {}) && hasNoOtherConstructors() &&
-					((scope.isEmpty() && (modifiers & ACC_ACCESS_FLAGS) == (classinfo.modifiers & ACC_ACCESS_FLAGS)) // constructor by default
-					|| classinfo.thisType.isAnonymous)) // anonymous class constructor
+					(classinfo.thisType.isAnonymous // anonymous class constructor
+					|| ((modifiers & ACC_ACCESS_FLAGS) == (classinfo.modifiers & ACC_ACCESS_FLAGS) && getScope().isEmpty()))) // constructor by default
 				||
 
 				(classinfo.modifiers & ACC_ENUM && (
-					(scope.isEmpty() && modifiers & ACC_PRIVATE &&
+					(modifiers & ACC_PRIVATE &&
 						descriptor == MethodDescriptor(classinfo.thisType, "<init>", VOID, {STRING, INT}) // enum constructor by default
-						&& hasNoOtherConstructors()) ||
+						&& hasNoOtherConstructors() && getScope().isEmpty()) ||
 					descriptor == MethodDescriptor(classinfo.thisType, "valueOf", &classinfo.thisType, {STRING}) || // Enum valueOf(String name)
-					descriptor == MethodDescriptor(classinfo.thisType, "values", new ArrayType(classinfo.thisType), {}) // Enum[] values()
+					descriptor == MethodDescriptor(classinfo.thisType, "values", ArrayType::getInstance(classinfo.thisType), {}) // Enum[] values()
 				));
 	}
 
 	Method::Method(modifiers_t modifiers, const MethodDescriptor& descriptor, const Attributes& attributes, const ClassInfo& classinfo):
 			ClassElement(modifiers), descriptor(descriptor), attributes(attributes), codeAttribute(attributes.get<CodeAttribute>()),
-			context(decompileCode(classinfo)), scope(context.methodScope) {
+			declaringClassinfo(classinfo), arena(Arena::getCurrent()) {
 
 		if(descriptor.isStaticInitializer()) {
 			if(modifiers != ACC_STATIC)
@@ -106,7 +107,27 @@ namespace jdecompiler {
 		}
 	}
 
+	const StringifyContext& Method::getContext() const {
+		call_once(decompileFlag, [this] () {
+			if(arena == nullptr) {
+				context = &decompileCode();
+			} else {
+				const Arena::Guard arenaGuard(*arena);
+				context = &decompileCode();
+			}
+		});
+
+		return *context;
+	}
+
 	string Method::toString(const ClassInfo& classinfo) const {
+		OutputWriter out;
+		writeTo(out, classinfo);
+		return out.release();
+	}
+
+	void Method::writeTo(OutputWriter& out, const ClassInfo& classinfo) const {
+		const StringifyContext& context = getContext();
 
 		if(codeAttribute != nullptr) {
 			if(modifiers & ACC_ABSTRACT)
@@ -122,7 +143,7 @@ namespace jdecompiler {
 		string str;
 
 		if(JDecompiler::getInstance().useOverrideAnnotation()) {
-			static const ClassType OVERRIDE_ANNOTATION("java/lang/Override");
+			static const ClassType& OVERRIDE_ANNOTATION = *ClassType::getInstance("java/lang/Override");
 
 			function<bool(const ClassInfo&)> checkOverride;
 
@@ -172,7 +193,7 @@ namespace jdecompiler {
 
 			if(const ExceptionsAttribute* exceptionsAttr = attributes.get<ExceptionsAttribute>())
 				str += " throws " + join<const ClassConstant*>(exceptionsAttr->exceptions,
-						[&classinfo] (auto clazz) { return (new ClassType(clazz->name))->toString(classinfo); });
+						[&classinfo] (auto clazz) { return ClassType::getInstance(clazz)->toString(classinfo); });
 
 			if(const AnnotationDefaultAttribute* annotationDefaultAttr = attributes.get<AnnotationDefaultAttribute>())
 				str += " default " + annotationDefaultAttr->toString(context.classinfo);
@@ -192,15 +213,26 @@ namespace jdecompiler {
 		if(!comment.empty())
 			comment += "method";
 
-		return str + (codeAttribute == nullptr || !errorMessage.empty() ? (comment.empty() ? ";" : "; // " + (string)comment) :
-				(comment.empty() ? " " : " /* " + (string)comment + " */ ") + scope.toString(context));
+		out << str;
+
+		if(codeAttribute == nullptr || !errorMessage.empty()) {
+			out << (comment.empty() ? ";" : "; // " + (string)comment);
+			return;
+		}
+
+		out << (comment.empty() ? " " : " /* " + (string)comment + " */ ");
+
+		if(JDecompiler::getInstance().stubsMode())
+			out << "{ throw null; }";
+		else
+			context.methodScope.writeTo(out, context);
 				//&context.classinfo == &classinfo ? context : DecompilationContext(context, classinfo))); // For anonymous classes
 	}
 
 	bool Method::canStringify(const ClassInfo& classinfo) const {
 
 		return !((!JDecompiler::getInstance().showAutogenerated() && isAutogenerated(classinfo)) ||
-				(descriptor.isStaticInitializer() && scope.isEmpty())) && // empty static {}
+				(descriptor.isStaticInitializer() && (JDecompiler::getInstance().stubsMode() || getScope().isEmpty()))) && // empty static {}
 
 				(!(modifiers & (ACC_SYNTHETIC | ACC_BRIDGE)) ||
 				(modifiers & ACC_SYNTHETIC && JDecompiler::getInstance().showSynthetic()) ||
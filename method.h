@@ -99,27 +99,40 @@ namespace jdecompiler {
 
 	struct Method: ClassElement {
 		private:
-			string errorMessage;
+			mutable string errorMessage;
 
 		public:
 			const MethodDescriptor& descriptor;
 			const Attributes& attributes;
 			const CodeAttribute* const codeAttribute;
-			const StringifyContext& context;
-
-		protected:
-			MethodScope& scope;
 
 		private:
+			const ClassInfo& declaringClassinfo;
+			Arena* const arena;
+
+			mutable once_flag decompileFlag;
+			mutable const StringifyContext* context = nullptr;
+
 			bool isAutogenerated(const ClassInfo&) const;
 
+			void addArguments(MethodScope&, uint32_t codeLength) const;
+
 		public:
 			Method(modifiers_t, const MethodDescriptor&, const Attributes&, const ClassInfo&);
 
-			const StringifyContext& decompileCode(const ClassInfo&);
+			const StringifyContext& decompileCode() const;
+
+			/* The code is decompiled on the first call in the arena of the class. Thread safe */
+			const StringifyContext& getContext() const;
+
+			inline MethodScope& getScope() const {
+				return getContext().methodScope;
+			}
 
 			virtual string toString(const ClassInfo&) const override;
 
+			void writeTo(OutputWriter&, const ClassInfo&) const;
+
 			virtual bool canStringify(const ClassInfo&) const override;
 
 			inline bool isStatic() const {
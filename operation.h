@@ -27,9 +27,9 @@ namespace jdecompiler {
 	};
 
 
-	struct Operation {
+	struct Operation: ArenaObject {
 		protected:
-			explicit constexpr Operation() noexcept {}
+			explicit Operation() noexcept {}
 
 		public:
 			virtual ~Operation() {}
@@ -37,6 +37,11 @@ namespace jdecompiler {
 
 			virtual string toString(const StringifyContext&) const = 0;
 
+			/* Scopes write their code directly into the output, other operations write the result of toString */
+			virtual void writeTo(OutputWriter& out, const StringifyContext& context) const {
+				out << toString(context);
+			}
+
 			virtual string toArrayInitString(const StringifyContext& context) const {
 				return toString(context);
 			}
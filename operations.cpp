@@ -25,25 +25,25 @@ namespace jdecompiler {
 	};
 
 	struct IntOperation: Operation {
-		constexpr IntOperation() noexcept {}
+		IntOperation() noexcept {}
 
 		virtual const Type* getReturnType() const override { return INT; }
 	};
 
 	struct AnyIntOperation: Operation {
-		constexpr AnyIntOperation() noexcept {}
+		AnyIntOperation() noexcept {}
 
 		virtual const Type* getReturnType() const override { return ANY_INT; }
 	};
 
 	struct BooleanOperation: Operation {
-		constexpr BooleanOperation() noexcept {}
+		BooleanOperation() noexcept {}
 
 		virtual const Type* getReturnType() const override { return BOOLEAN; }
 	};
 
 	struct VoidOperation: Operation {
-		constexpr VoidOperation() noexcept {}
+		VoidOperation() noexcept {}
 
 		virtual const Type* getReturnType() const override { return VOID; }
 	};
@@ -11,7 +11,7 @@ namespace jdecompiler {
 		protected:
 			ArrayLoadOperation(const Type* elementType, const DecompilationContext& context):
 					index(context.stack.popAs(INT)), array(context.stack.pop()),
-					returnType(array->getReturnTypeAs(new ArrayType(elementType))->elementType) {
+					returnType(array->getReturnTypeAs(ArrayType::getInstance(elementType))->elementType) {
 				index->allowImplicitCast();
 			}
 
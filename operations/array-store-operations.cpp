@@ -10,7 +10,7 @@ namespace jdecompiler {
 
 		public:
 			ArrayStoreOperation(const Type* elementType, const DecompilationContext& context): value(context.stack.popAs(elementType)),
-					index(context.stack.popAs(INT)), array(context.stack.popAs(new ArrayType(elementType))) {
+					index(context.stack.popAs(INT)), array(context.stack.popAs(ArrayType::getInstance(elementType))) {
 
 				index->allowImplicitCast();
 				value->allowImplicitCast();
@@ -56,7 +56,7 @@ namespace jdecompiler {
 
 	struct CheckCastOperation: CastOperation {
 		CheckCastOperation(const DecompilationContext& context, uint16_t index):
-				CastOperation(context, AnyObjectType::getInstance(), parseReferenceType(context.constPool.get<ClassConstant>(index)->name), true) {}
+				CastOperation(context, AnyObjectType::getInstance(), context.constPool.getReferenceType(index), true) {}
 	};
 }
 
@@ -46,14 +46,19 @@ namespace jdecompiler {
 						return "else";
 					}
 
-					virtual string toStringImpl(const StringifyContext& context) const override {
+					virtual void writeImpl(OutputWriter& out, const StringifyContext& context) const override {
 						if(code.size() == 1 && instanceof<const IfScope*>(code[0])) { // else if
-							return getHeader(context) + code[0]->toString(context);
+							out << getHeader(context);
+							code[0]->writeTo(out, context);
+							return;
 						}
 						if(code.size() == 2 && instanceof<const IfScope*>(code[0]) && instanceof<const ElseScope*>(code[1])) { // else if ... else
-							return getHeader(context) + code[0]->toString(context) + code[1]->toString(context);
+							out << getHeader(context);
+							code[0]->writeTo(out, context);
+							code[1]->writeTo(out, context);
+							return;
 						}
-						return this->Scope::toStringImpl(context);
+						this->Scope::writeImpl(out, context);
 					}
 
 					virtual bool canOmitBrackets() const override {
@@ -112,12 +117,14 @@ namespace jdecompiler {
 				return "if(" + condition->toString(context) + ')';
 			}
 
-			virtual string toStringImpl(const StringifyContext& context) const override {
-				if(assertOperation != nullptr)
-					return "assert " + assertOperation->toString(context) + ';';
+			virtual void writeImpl(OutputWriter& out, const StringifyContext& context) const override {
+				if(assertOperation != nullptr) {
+					out << "assert " << assertOperation->toString(context) << ';';
+					return;
+				}
 
-				return ConditionScope::toStringImpl(context) +
-						(elseScope != nullptr && !this->bracketsOmitted() ? " " : context.classinfo.getIndent());
+				ConditionScope::writeImpl(out, context);
+				out << (elseScope != nullptr && !this->bracketsOmitted() ? " " : context.classinfo.getIndent());
 			}
 
 			virtual bool canOmitBrackets() const override {
@@ -158,7 +165,7 @@ namespace jdecompiler {
 														dynamic_cast<const InvokespecialOperation*>(athrow->exception)) {
 
 													static const MethodDescriptor
-															AssertionErrorConstructor(*new ClassType("java/lang/AssertionError"), "<init>", VOID);
+															AssertionErrorConstructor(*ClassType::getInstance("java/lang/AssertionError"), "<init>", VOID);
 
 													if(constructorInvoke->descriptor == AssertionErrorConstructor) {
 														assertOperation = andOperation->operand2->invert();
@@ -279,7 +286,7 @@ namespace jdecompiler {
 	struct InfiniteLoopScope: LoopScope {
 		public:
 			struct TrueConstOperation: ConditionOperation {
-				private: constexpr TrueConstOperation() noexcept {}
+				private: TrueConstOperation() noexcept {}
 
 				public:
 					virtual const Type* getReturnType() const override {
@@ -378,13 +385,13 @@ namespace jdecompiler {
 					value(context.stack.popAs(ANY_INT)), defaultIndex(context.posToIndex(context.pos + defaultOffset)),
 					indexTable(offsetTableToIndexTable(context, offsetTable)) {}
 
-			virtual string toStringImpl(const StringifyContext& context) const override {
+			virtual void writeImpl(OutputWriter& out, const StringifyContext& context) const override {
 				context.classinfo.increaseIndent(2);
 
-				string str = "switch(" + value->toString(context) + ") {\n";
-				const size_t baseSize = str.size();
+				out << "switch(" << value->toString(context) << ") {\n";
+				const size_t baseSize = out.size();
 
-				const map<uint32_t, index_t>& exprIndexTable = context.exprIndexTable;
+				const vector<index_t>& exprIndexTable = context.exprIndexTable;
 
 				const index_t defaultExprIndex = exprIndexTable.at(defaultIndex);
 
@@ -407,31 +414,33 @@ namespace jdecompiler {
 							[&exprIndexTable, i] (const auto& entry) { return entry.first; });
 
 					if(!cases.empty()) {
-						str += context.classinfo.version.majorVersion >= JAVA_12 ?
+						out << (context.classinfo.version.majorVersion >= JAVA_12 ?
 							context.classinfo.getIndent() + (string)"case " + join<jint>(cases, [&context] (jint value) { return to_string(value); }) + ":\n" :
 							join<jint>(cases, [&context] (jint value)
-								{ return context.classinfo.getIndent() + (string)"case " + to_string(value) + ":\n"; }, EMPTY_STRING);
+								{ return context.classinfo.getIndent() + (string)"case " + to_string(value) + ":\n"; }, EMPTY_STRING));
 
 						cases.clear();
 					}
 
 					if(i == defaultExprIndex)
-						str += context.classinfo.getIndent() + (string)"default:\n";
+						out << context.classinfo.getIndent() << "default:\n";
 
 					context.classinfo.increaseIndent();
 
-					str += context.classinfo.getIndent() + operation->toString(context) + operation->getBackSeparator(context.classinfo);
+					out << context.classinfo.getIndent();
+					operation->writeTo(out, context);
+					out << operation->getBackSeparator(context.classinfo);
 					i++;
 				}
 
 				context.classinfo.reduceIndent(2);
 
-				if(str.size() == baseSize) {
-					str[baseSize - 1] = '}';
-					return str;
+				if(out.size() == baseSize) {
+					out.back() = '}';
+					return;
 				}
 
-				return str + context.classinfo.getIndent() + '}';
+				out << context.classinfo.getIndent() << '}';
 			}
 
 			virtual bool isBreakable() const override {
@@ -445,8 +454,8 @@ namespace jdecompiler {
 		EmptyInfiniteLoopScope(const DecompilationContext& context):
 				Scope(context.index, context.index, context) {}
 
-		virtual string toStringImpl(const StringifyContext&) const override {
-			return JDecompiler::getInstance().omitBrackets() ? "while(true);" : "while(true) {}";
+		virtual void writeImpl(OutputWriter& out, const StringifyContext&) const override {
+			out << (JDecompiler::getInstance().omitBrackets() ? "while(true);" : "while(true) {}");
 		}
 	};
 
@@ -104,7 +104,7 @@ namespace jdecompiler {
 		protected:
 			mutable bool inverted = false;
 
-			constexpr ConditionOperation() noexcept {}
+			ConditionOperation() noexcept {}
 
 		public:
 			virtual string toString(const StringifyContext& context) const = 0;
@@ -12,11 +12,10 @@ namespace jdecompiler {
 		if(JDecompiler::getInstance().canUseCustomConstants() && context.fieldinfo == nullptr) {
 			const Field* foundConstant = nullptr;
 
-			for(const Field* field : context.classinfo.getConstants()) {
+			/* Only the constants with the same value are checked */
+			for(const Field* field : context.classinfo.getConstants(value)) {
 
-				if(field->descriptor.type.isSubtypeOf(type) && field->isConstant() &&
-						instanceof<const constantTypeOf<T>*>(field->constantValueAttribute->value) &&
-						static_cast<const constantTypeOf<T>*>(field->constantValueAttribute->value)->value == value) {
+				if(field->descriptor.type.isSubtypeOf(type)) {
 
 					if(foundConstant == nullptr) { // Found first constant
 						foundConstant = field;
@@ -109,7 +108,7 @@ namespace jdecompiler {
 
 		if(JDecompiler::getInstance().canUseConstants()) {
 
-			static const ClassType MathClass("java/lang/Math");
+			static const ClassType& MathClass = *ClassType::getInstance("java/lang/Math");
 
 			static const FieldDescriptor PIField("PI", DOUBLE);
 
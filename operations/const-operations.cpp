@@ -210,7 +210,7 @@ namespace jdecompiler {
 
 	struct EmptyStringConstOperation: Operation {
 		private:
-			constexpr EmptyStringConstOperation() noexcept {}
+			EmptyStringConstOperation() noexcept {}
 
 		public:
 			virtual string toString(const StringifyContext&) const override {
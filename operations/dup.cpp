@@ -48,13 +48,10 @@ namespace jdecompiler {
 	struct DupX1Operation: AbstractDupOperation<TypeSize::FOUR_BYTES> {
 		DupX1Operation(const DecompilationContext& context): AbstractDupOperation<TypeSize::FOUR_BYTES>(context) {
 			if(context.stack.size() < 2)
-				throw IllegalStackStateException("Too less operations on stack for dup_x1: required 2, got " + context.stack.size());
+				throw IllegalStackStateException("Too less operations on stack for dup_x1: required 2, got " + to_string(context.stack.size()));
 
-			const Operation
-				*operation1 = context.stack.pop(),
-				*operation2 = context.stack.pop();
-			TypeSizeTemplatedOperation<TypeSize::FOUR_BYTES>::checkTypeSize(operation2->getReturnType());
-			context.stack.push(operation1, operation2);
+			TypeSizeTemplatedOperation<TypeSize::FOUR_BYTES>::checkTypeSize(context.stack.lookup(1)->getReturnType());
+			context.stack.moveTopDown(1);
 		}
 	};
 
@@ -62,17 +59,12 @@ namespace jdecompiler {
 	struct DupX2Operation: AbstractDupOperation<TypeSize::FOUR_BYTES> {
 		DupX2Operation(const DecompilationContext& context): AbstractDupOperation<TypeSize::FOUR_BYTES>(context) {
 			if(context.stack.size() < 3)
-				throw IllegalStackStateException("Too less operations on stack for dup_x2: required 3, got " + context.stack.size());
+				throw IllegalStackStateException("Too less operations on stack for dup_x2: required 3, got " + to_string(context.stack.size()));
 
-			const Operation
-				*operation1 = context.stack.pop(),
-				*operation2 = context.stack.pop(),
-				*operation3 = context.stack.pop();
+			checkTypeSize(context.stack.lookup(1)->getReturnType());
+			checkTypeSize(context.stack.lookup(2)->getReturnType());
 
-			checkTypeSize(operation2->getReturnType());
-			checkTypeSize(operation3->getReturnType());
-
-			context.stack.push(operation1, operation3, operation2);
+			context.stack.moveTopDown(2);
 		}
 	};
 
@@ -80,15 +72,11 @@ namespace jdecompiler {
 	struct Dup2X1Operation: AbstractDupOperation<TypeSize::EIGHT_BYTES> {
 		Dup2X1Operation(const DecompilationContext& context): AbstractDupOperation<TypeSize::EIGHT_BYTES>(context) {
 			if(context.stack.size() < 2)
-				throw IllegalStackStateException("Too less operations on stack for dup2_x1: required 2, got " + context.stack.size());
-
-			const Operation
-				*operation1 = context.stack.pop(),
-				*operation2 = context.stack.pop();
+				throw IllegalStackStateException("Too less operations on stack for dup2_x1: required 2, got " + to_string(context.stack.size()));
 
-			checkTypeSize<TypeSize::FOUR_BYTES>(operation2->getReturnType());
+			checkTypeSize<TypeSize::FOUR_BYTES>(context.stack.lookup(1)->getReturnType());
 
-			context.stack.push(operation1, operation2);
+			context.stack.moveTopDown(1);
 		}
 	};
 
@@ -96,15 +84,11 @@ namespace jdecompiler {
 	struct Dup2X2Operation: AbstractDupOperation<TypeSize::EIGHT_BYTES> {
 		Dup2X2Operation(const DecompilationContext& context): AbstractDupOperation<TypeSize::EIGHT_BYTES>(context) {
 			if(context.stack.size() < 2)
-				throw IllegalStackStateException("Too less operations on stack for dup2_x2: required 2, got " + context.stack.size());
-
-			const Operation
-				*operation1 = context.stack.pop(),
-				*operation2 = context.stack.pop();
+				throw IllegalStackStateException("Too less operations on stack for dup2_x2: required 2, got " + to_string(context.stack.size()));
 
-			checkTypeSize(operation2->getReturnType());
+			checkTypeSize(context.stack.lookup(1)->getReturnType());
 
-			context.stack.push(operation1, operation2);
+			context.stack.moveTopDown(1);
 		}
 	};
 }
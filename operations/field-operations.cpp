@@ -16,7 +16,7 @@ namespace jdecompiler {
 					FieldOperation(fieldref->clazz, fieldref->nameAndType) {}
 
 			FieldOperation(const DecompilationContext& context, uint16_t index):
-					FieldOperation(context.constPool.get<FieldrefConstant>(index)) {}
+					FieldOperation(*ClassType::getInstance(context.constPool.get<FieldrefConstant>(index)->clazz), context.constPool.getFieldDescriptor(index)) {}
 
 			inline string staticFieldToString(const StringifyContext& context) const {
 				return clazz == context.classinfo.thisType && !context.getCurrentScope()->hasVariable(descriptor.name) ?
@@ -10,7 +10,7 @@ namespace jdecompiler {
 
 		public:
 			InstanceofOperation(const DecompilationContext& context, uint16_t index):
-					type(parseReferenceType(context.constPool.get<ClassConstant>(index)->name)), object(context.stack.pop()) {}
+					type(context.constPool.getReferenceType(index)), object(context.stack.pop()) {}
 
 			virtual string toString(const StringifyContext& context) const override {
 				return toStringPriority(object, context, Associativity::LEFT) + " instanceof " + type->toString(context.classinfo);
@@ -42,7 +42,7 @@ namespace jdecompiler {
 					descriptor(descriptor), arguments(popArguments(context)), isStatic(isStatic) {}
 
 			InvokeOperation(const DecompilationContext& context, uint16_t index, bool isStatic):
-					InvokeOperation(context, context.constPool.get<MethodrefConstant>(index), isStatic) {}
+					InvokeOperation(context, context.constPool.getMethodDescriptor(index), isStatic) {}
 
 			inline string argumentsToString(const StringifyContext& context) const {
 				if(!arguments.empty()) {
@@ -50,18 +50,16 @@ namespace jdecompiler {
 					const Class* clazz = JDecompiler::getInstance().getClass(descriptor.clazz.getEncodedName());
 
 					if(clazz != nullptr) {
-						const vector<const Method*> overloadedMethods = clazz->getMethods([this] (const Method* method) {
-							// From a non-static context, we can invoke both non-static and static methods
-							return (!this->isStatic || method->isStatic()) && method->descriptor.name == this->descriptor.name
-									&& method->descriptor.arguments.size() == this->descriptor.arguments.size() && method->descriptor != this->descriptor;
-						});
+						const OverloadSet& overloadSet = clazz->getOverloadSet(descriptor.name, descriptor.arguments.size(), isStatic);
+
+						const auto isOverloaded = [this] (const Method* method) { return method->descriptor != this->descriptor; };
 
 						const function<void()> allowAllImplicitCast = [this] () {
 							for(const Operation* argument : arguments)
 								argument->allowImplicitCast();
 						};
 
-						if(overloadedMethods.empty()) {
+						if(none_of(overloadSet.methods.begin(), overloadSet.methods.end(), isOverloaded)) {
 							allowAllImplicitCast();
 
 						} else {
@@ -75,36 +73,45 @@ namespace jdecompiler {
 
 							if(implicitTypes != descriptor.arguments) {
 
-								const function<bool(const vector<const Type*>&, const vector<const Type*>&, status_t*)> canImplicitCast =
-									[] (const vector<const Type*>& types1, const vector<const Type*>& types2, status_t* status) {
-										return equal(types1.begin(), types1.end(), types2.begin(),
-											[status] (const Type* type1, const Type* type2) {
-												const status_t currentStatus = type1->implicitCastStatus(type2);
-												*status += currentStatus;
-												return currentStatus != Type::N_STATUS;
-											});
-								};
+								/* The result depends only on the invoked descriptor and the implicit types */
+								vector<const Type*> key(descriptor.arguments);
+								key.push_back(descriptor.returnType);
+								key.insert(key.end(), implicitTypes.begin(), implicitTypes.end());
+
+								const bool canAllowImplicitCast = overloadSet.resolve(key, [this, &overloadSet, &isOverloaded, &implicitTypes] () {
+
+									const function<bool(const vector<const Type*>&, const vector<const Type*>&, status_t*)> canImplicitCast =
+										[] (const vector<const Type*>& types1, const vector<const Type*>& types2, status_t* status) {
+											return equal(types1.begin(), types1.end(), types2.begin(),
+												[status] (const Type* type1, const Type* type2) {
+													const status_t currentStatus = type1->implicitCastStatus(type2);
+													*status += currentStatus;
+													return currentStatus != Type::N_STATUS;
+												});
+									};
 
 
-								map<const Method*, status_t> resolvedMethods;
+									map<const Method*, status_t> resolvedMethods;
 
-								status_t baseStatus = 0;
+									status_t baseStatus = 0;
 
-								if(canImplicitCast(implicitTypes, descriptor.arguments, &baseStatus)) {
+									if(!canImplicitCast(implicitTypes, descriptor.arguments, &baseStatus))
+										return false;
 
-									for(const Method* method : overloadedMethods) {
+									for(const Method* method : overloadSet.methods) {
 										status_t status = 0;
 
-										if(canImplicitCast(implicitTypes, method->descriptor.arguments, &status)) {
+										if(isOverloaded(method) && canImplicitCast(implicitTypes, method->descriptor.arguments, &status)) {
 											resolvedMethods[method] = status;
 										}
 									}
 
-									if(resolvedMethods.empty() || all_of(resolvedMethods.begin(), resolvedMethods.end(),
-											[baseStatus] (const auto& it) { return it.second > baseStatus; })) {
+									return resolvedMethods.empty() || all_of(resolvedMethods.begin(), resolvedMethods.end(),
+											[baseStatus] (const auto& it) { return it.second > baseStatus; });
+								});
 
-										allowAllImplicitCast();
-									}
+								if(canAllowImplicitCast) {
+									allowAllImplicitCast();
 								}
 							}
 						}
@@ -249,6 +256,8 @@ namespace jdecompiler {
 						if(classType.isAnonymous) {
 							const Class* clazz = JDecompiler::getInstance().getClass(classType.getEncodedName());
 							if(clazz != nullptr) {
+								const lock_guard<recursive_mutex> lock(clazz->classinfo.getFormattingMutex());
+
 								clazz->classinfo.copyFormattingFrom(context.classinfo);
 								const string result = "new " + clazz->anonymousToString();
 								clazz->classinfo.resetFormatting();
@@ -58,13 +58,13 @@ namespace jdecompiler {
 
 	struct ANewArrayOperation: NewArrayOperation {
 		ANewArrayOperation(const DecompilationContext& context, uint16_t index):
-				NewArrayOperation(context, new ArrayType(parseReferenceType(context.constPool.get<ClassConstant>(index)->name))) {}
+				NewArrayOperation(context, ArrayType::getInstance(context.constPool.getReferenceType(index))) {}
 	};
 
 
 	struct MultiANewArrayOperation: NewArrayOperation {
 		MultiANewArrayOperation(const DecompilationContext& context, uint16_t index, uint16_t dimensions):
-				NewArrayOperation(context, safe_cast<const ArrayType*>(parseReferenceType(context.constPool.get<ClassConstant>(index)->name)),
+				NewArrayOperation(context, safe_cast<const ArrayType*>(context.constPool.getReferenceType(index)),
 				dimensions) {
 			if(dimensions > arrayType->nestingLevel) {
 				throw DecompilationException("The nesting level of the multianewarray instruction (" + to_string(dimensions) + ")"
@@ -137,16 +137,24 @@ namespace jdecompiler {
 	void Scope::finalize(const DecompilationContext&) const {}
 
 	string Scope::toString(const StringifyContext& context) const {
+		OutputWriter out;
+		writeTo(out, context);
+		return out.release();
+	}
 
+	void Scope::writeTo(OutputWriter& out, const StringifyContext& context) const {
 		context.enterScope(this);
-		const string str = this->toStringImpl(context);
+		this->writeImpl(out, context);
 		context.exitScope(this);
-		return str;
 	}
 
-	string Scope::toStringImpl(const StringifyContext& context) const {
+	void Scope::writeImpl(OutputWriter& out, const StringifyContext& context) const {
 		const string header = getHeader(context);
-		string str = (label.empty() ? EMPTY_STRING : label + ": ") + header;
+
+		if(!label.empty())
+			out << label << ": ";
+
+		out << header;
 
 		context.classinfo.increaseIndent();
 
@@ -157,20 +165,21 @@ namespace jdecompiler {
 			switch(this->getStringifiedOperationsCount()) {
 				case 0:
 					context.classinfo.reduceIndent();
-					return str + ';';
+					out << ';';
+					return;
 				case 1:
-					str += '\n';
+					out << '\n';
 					omitBrackets = true;
 					break;
 				default:
-					str += header.empty() ? "{\n" : " {\n";
+					out << (header.empty() ? "{\n" : " {\n");
 			}
 
 		} else {
-			str += header.empty() ? "{\n" : " {\n";
+			out << (header.empty() ? "{\n" : " {\n");
 		}
 
-		const size_t baseSize = str.size();
+		const size_t baseSize = out.size();
 
 		for(auto i = code.begin(); i != code.end(); ++i) {
 			const Operation* operation = *i;
@@ -178,22 +187,23 @@ namespace jdecompiler {
 			if(operation->canStringify() && canPrintNextOperation(i)) {
 				assert(operation->getReturnType() == VOID);
 
-				str += operation->getFrontSeparator(context.classinfo) + operation->toString(context) +
-						operation->getBackSeparator(context.classinfo);
+				out << operation->getFrontSeparator(context.classinfo);
+				operation->writeTo(out, context);
+				out << operation->getBackSeparator(context.classinfo);
 			}
 		}
 
 		context.classinfo.reduceIndent();
 
 		if(omitBrackets)
-			return str;
+			return;
 
-		if(str.size() == baseSize) {
-			str.back() = '}';
-			return str;
+		if(out.size() == baseSize) {
+			out.back() = '}';
+			return;
 		}
 
-		return str + context.classinfo.getIndent() + '}';
+		out << context.classinfo.getIndent() << '}';
 	}
 
 
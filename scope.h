@@ -86,7 +86,9 @@ namespace jdecompiler {
 
 			virtual string toString(const StringifyContext&) const override final;
 
-			virtual string toStringImpl(const StringifyContext&) const;
+			virtual void writeTo(OutputWriter&, const StringifyContext&) const override final;
+
+			virtual void writeImpl(OutputWriter&, const StringifyContext&) const;
 
 
 			bool bracketsOmitted() const;
@@ -0,0 +1,64 @@
+#ifndef JDECOMPILER_START_INDEX_QUEUE_CPP
+#define JDECOMPILER_START_INDEX_QUEUE_CPP
+
+#include <queue>
+
+namespace jdecompiler {
+
+	using std::priority_queue;
+	using std::sort;
+
+	/* Blocks or scopes which are not started yet, ordered by the start index, so each one is checked only when it is reached.
+	   Elements which start at the same time are activated in the order in which they were added */
+	template<typename T>
+	struct StartIndexQueue {
+		private:
+			struct Entry {
+				index_t startIndex;
+				size_t order;
+				const T* element;
+			};
+
+			struct Later {
+				inline bool operator()(const Entry& entry1, const Entry& entry2) const {
+					return entry1.startIndex != entry2.startIndex ? entry1.startIndex > entry2.startIndex : entry1.order > entry2.order;
+				}
+			};
+
+			priority_queue<Entry, vector<Entry>, Later> entries;
+			vector<Entry> started;
+			size_t count = 0;
+
+		public:
+			inline void push(const T* element) {
+				entries.push(Entry { element->start(), count++, element });
+			}
+
+			inline bool empty() const {
+				return entries.empty();
+			}
+
+			/* Removes all elements which start at or before the index and calls the function for them in the order of adding.
+			   Elements pushed by the function are activated by the next call */
+			template<typename F>
+			void popStarted(index_t index, const F& activate) {
+				if(entries.empty() || entries.top().startIndex > index)
+					return;
+
+				started.clear();
+
+				do {
+					started.push_back(entries.top());
+					entries.pop();
+				} while(!entries.empty() && entries.top().startIndex <= index);
+
+				if(started.size() > 1)
+					sort(started.begin(), started.end(), [] (const Entry& entry1, const Entry& entry2) { return entry1.order < entry2.order; });
+
+				for(const Entry& entry : started)
+					activate(entry.element);
+			}
+	};
+}
+
+#endif
@@ -0,0 +1,194 @@
+#ifndef JDECOMPILER_STATS_CPP
+#define JDECOMPILER_STATS_CPP
+
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+
+namespace jdecompiler {
+
+	/* Thread and CPU time of each phase of the decompilation and counters of the decompiled entities.
+	   Nested phases are not included in the time of the outer phase. The times of a phase are summed over all threads,
+	   so with several jobs the sum of the phases is greater than the wall time of the run, which is printed separately.
+	   Does nothing if the statistics is not enabled by --stats */
+	struct Stats {
+		public:
+			enum class Phase {
+				READ, CONSTANT_POOL, ATTRIBUTES, DISASSEMBLY, BLOCKS, DECOMPILATION, REDUCE_VARIABLE_TYPES, STRINGIFY, WRITE
+			};
+
+			enum class Counter {
+				CLASSES, METHODS, INSTRUCTIONS, OPERATIONS, SCOPES
+			};
+
+			enum class Format { NONE, TEXT, JSON };
+
+		private:
+			static constexpr size_t PHASES_COUNT = static_cast<size_t>(Phase::WRITE) + 1,
+			                        COUNTERS_COUNT = static_cast<size_t>(Counter::SCOPES) + 1;
+
+			static constexpr const char* PHASE_NAMES[PHASES_COUNT] = {
+				"read", "constant_pool", "attributes", "disassembly", "blocks", "decompilation", "reduce_variable_types", "stringify", "write"
+			};
+
+			static constexpr const char* COUNTER_NAMES[COUNTERS_COUNT] = {
+				"classes", "methods", "instructions", "operations", "scopes"
+			};
+
+			static inline Format format = Format::NONE;
+			static inline std::chrono::steady_clock::time_point startTime;
+
+			static inline atomic<uint64_t> threadTimes[PHASES_COUNT], cpuTimes[PHASES_COUNT], counters[COUNTERS_COUNT];
+
+
+			static inline uint64_t wallNanos() {
+				return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+						std::chrono::steady_clock::now().time_since_epoch()).count());
+			}
+
+			/* CPU time of the current thread, or of the whole process if the system cannot measure it for a thread */
+			static inline uint64_t cpuNanos() {
+				#ifdef __unix__
+					timespec time;
+					clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+					return static_cast<uint64_t>(time.tv_sec) * 1000000000 + static_cast<uint64_t>(time.tv_nsec);
+				#else
+					return static_cast<uint64_t>(std::clock()) * (1000000000 / CLOCKS_PER_SEC);
+				#endif
+			}
+
+			static inline double toMillis(uint64_t nanos) {
+				return nanos / 1e6;
+			}
+
+		public:
+			static inline bool enabled() {
+				return format != Format::NONE;
+			}
+
+			/* Must be called before any other thread is started */
+			static void enable(Format newFormat) {
+				format = newFormat;
+				startTime = std::chrono::steady_clock::now();
+			}
+
+			static inline void count(Counter counter, uint64_t value = 1) {
+				if(enabled())
+					counters[static_cast<size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+			}
+
+
+			/* Measures the time of the phase while it exists */
+			struct Timer {
+				private:
+					const Phase phase;
+					const bool active;
+					Timer* const parent;
+
+					uint64_t wallStart = 0, cpuStart = 0, wallTime = 0, cpuTime = 0;
+
+					static inline thread_local Timer* current = nullptr;
+
+					inline void pause() {
+						wallTime += wallNanos() - wallStart;
+						cpuTime += cpuNanos() - cpuStart;
+					}
+
+					inline void resume() {
+						wallStart = wallNanos();
+						cpuStart = cpuNanos();
+					}
+
+				public:
+					explicit Timer(Phase phase): phase(phase), active(enabled()), parent(active ? current : nullptr) {
+						if(!active)
+							return;
+
+						if(parent != nullptr)
+							parent->pause();
+
+						current = this;
+						resume();
+					}
+
+					Timer(const Timer&) = delete;
+					Timer& operator=(const Timer&) = delete;
+
+					~Timer() {
+						if(!active)
+							return;
+
+						pause();
+
+						const size_t index = static_cast<size_t>(phase);
+						threadTimes[index].fetch_add(wallTime, std::memory_order_relaxed);
+						cpuTimes[index].fetch_add(cpuTime, std::memory_order_relaxed);
+
+						current = parent;
+
+						if(parent != nullptr)
+							parent->resume();
+					}
+			};
+
+
+			static void print(ostream& out, const string& version) {
+				if(!enabled())
+					return;
+
+				const uint64_t totalTime = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+						std::chrono::steady_clock::now() - startTime).count());
+
+				const auto flags = out.flags();
+				const auto precision = out.precision();
+
+				out << std::fixed << std::setprecision(3);
+
+				uint64_t threadTimesSum = 0, cpuTimesSum = 0;
+
+				for(size_t i = 0; i < PHASES_COUNT; i++) {
+					threadTimesSum += threadTimes[i].load();
+					cpuTimesSum += cpuTimes[i].load();
+				}
+
+				if(format == Format::JSON) {
+					out << "{\"version\": \"" << version << "\", \"wall_ms\": " << toMillis(totalTime) <<
+							", \"thread_ms\": " << toMillis(threadTimesSum) << ", \"cpu_ms\": " << toMillis(cpuTimesSum) << ", \"phases\": {";
+
+					for(size_t i = 0; i < PHASES_COUNT; i++)
+						out << (i == 0 ? "" : ", ") << '"' << PHASE_NAMES[i] << "\": {\"thread_ms\": " << toMillis(threadTimes[i].load()) <<
+								", \"cpu_ms\": " << toMillis(cpuTimes[i].load()) << '}';
+
+					out << "}, \"counters\": {";
+
+					for(size_t i = 0; i < COUNTERS_COUNT; i++)
+						out << (i == 0 ? "" : ", ") << '"' << COUNTER_NAMES[i] << "\": " << counters[i].load();
+
+					out << "}}" << endl;
+
+				} else {
+					out << "Statistics:\n" << std::left <<
+							"  " << std::setw(24) << "phase" << std::right << std::setw(14) << "thread, ms" << std::setw(14) << "cpu, ms" << '\n';
+
+					for(size_t i = 0; i < PHASES_COUNT; i++)
+						out << std::left << "  " << std::setw(24) << PHASE_NAMES[i] << std::right <<
+								std::setw(14) << toMillis(threadTimes[i].load()) << std::setw(14) << toMillis(cpuTimes[i].load()) << '\n';
+
+					out << std::left << "  " << std::setw(24) << "all phases" << std::right <<
+							std::setw(14) << toMillis(threadTimesSum) << std::setw(14) << toMillis(cpuTimesSum) << '\n';
+
+					out << std::left << "  " << std::setw(24) << "wall time" << std::right << std::setw(14) << toMillis(totalTime) << "\n\n";
+
+					for(size_t i = 0; i < COUNTERS_COUNT; i++)
+						out << std::left << "  " << std::setw(24) << COUNTER_NAMES[i] << std::right << std::setw(14) << counters[i].load() << '\n';
+
+					out << std::flush;
+				}
+
+				out.flags(flags);
+				out.precision(precision);
+			}
+	};
+}
+
+#endif
@@ -8,18 +8,18 @@ namespace jdecompiler {
 	struct StringifyContext final: DecompilationAndStringifyContext {
 
 		public:
-			const map<uint32_t, index_t>& exprIndexTable;
+			const vector<index_t>& exprIndexTable;
 
 		protected:
 			StringifyContext(const DisassemblerContext& disassemblerContext, const ClassInfo& classinfo, MethodScope& methodScope,
-					modifiers_t modifiers, const MethodDescriptor& descriptor, const Attributes& attributes, const map<uint32_t, index_t>& exprIndexTable):
+					modifiers_t modifiers, const MethodDescriptor& descriptor, const Attributes& attributes, const vector<index_t>& exprIndexTable):
 					DecompilationAndStringifyContext(disassemblerContext, classinfo,
 					methodScope, modifiers, descriptor, attributes), exprIndexTable(exprIndexTable) {}
 
 		public:
 			StringifyContext(const DisassemblerContext& disassemblerContext, const ClassInfo& classinfo, MethodScope* methodScope,
 					modifiers_t modifiers, const MethodDescriptor& descriptor, const Attributes& attributes):
-					StringifyContext(disassemblerContext, classinfo, *methodScope, modifiers, descriptor, attributes, *new map<uint32_t, index_t>()) {}
+					StringifyContext(disassemblerContext, classinfo, *methodScope, modifiers, descriptor, attributes, *new vector<index_t>()) {}
 
 			StringifyContext(const DecompilationContext& context):
 					StringifyContext(context.disassemblerContext, context.classinfo, context.methodScope,
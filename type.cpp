@@ -5,8 +5,8 @@
 
 namespace jdecompiler {
 
-	template<bool isNoexcept, bool widest>
-	const Type* Type::cast0(const Type* type) const {
+	template<bool widest>
+	const Type* Type::tryCast(const Type* type) const {
 
 		// I love such constructions in C++ :)
 		// It's a pointer to a member function
@@ -19,12 +19,43 @@ namespace jdecompiler {
 			return castedType;
 		}
 
-		(type->*reversedCastImplFunc)(this);
-
 		if(this->canReverseCast(type) && (castedType = (type->*reversedCastImplFunc)(this)) != nullptr) {
 			return castedType;
 		}
 
+		return nullptr;
+	}
+
+	template<bool widest>
+	const Type* Type::tryCastMemoized(const Type* type) const {
+		struct TypesHash {
+			inline size_t operator()(const pair<const Type*, const Type*>& types) const noexcept {
+				return std::hash<const Type*>()(types.first) * 31 + std::hash<const Type*>()(types.second);
+			}
+		};
+
+		/* Each thread has its own table, so it is not locked */
+		static thread_local std::unordered_map<pair<const Type*, const Type*>, const Type*, TypesHash> castedTypes;
+
+		const pair<const Type*, const Type*> key(this, type);
+
+		const auto found = castedTypes.find(key);
+		if(found != castedTypes.end())
+			return found->second;
+
+		const Type* castedType = tryCast<widest>(type);
+		castedTypes.emplace(key, castedType);
+		return castedType;
+	}
+
+	template<bool isNoexcept, bool widest>
+	const Type* Type::cast0(const Type* type) const {
+		const Type* castedType = this->canMemoizeCasts() && type->canMemoizeCasts() ?
+				tryCastMemoized<widest>(type) : tryCast<widest>(type);
+
+		if(castedType != nullptr)
+			return castedType;
+
 		if constexpr(isNoexcept)
 			return nullptr;
 		else
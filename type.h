@@ -60,6 +60,13 @@ namespace jdecompiler {
 			}
 
 
+		private:
+			template<bool widest>
+			const Type* tryCast(const Type*) const;
+
+			template<bool widest>
+			const Type* tryCastMemoized(const Type*) const;
+
 		public:
 			template<bool isNoexcept, bool widest>
 			const Type* cast0(const Type*) const;
@@ -106,6 +113,12 @@ namespace jdecompiler {
 				return true;
 			}
 
+			/* Only for the types which are never deleted and which are cast regardless of the loaded classes.
+			   The results of casts between such types are memoized */
+			inline virtual bool canMemoizeCasts() const {
+				return false;
+			}
+
 			virtual bool isSubtypeOfImpl(const Type*) const = 0;
 
 			inline virtual bool isStrictSubtypeOfImpl(const Type* other) const {
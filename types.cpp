@@ -91,8 +91,8 @@ namespace jdecompiler {
 			case 'F': ++str; return FLOAT;
 			case 'D': ++str; return DOUBLE;
 			case 'Z': ++str; return BOOLEAN;
-			case 'L': return new ClassType(str += 1);
-			case '[': return new ArrayType(str);
+			case 'L': return ClassType::getInstance(str += 1);
+			case '[': return ArrayType::getInstance(str);
 			case 'T': return new ParameterType(str += 1);
 			default:
 				throw InvalidTypeNameException(str);
@@ -125,14 +125,14 @@ namespace jdecompiler {
 
 
 	const ReferenceType* parseReferenceType(const char* str) {
-		return str[0] == '[' ? (const ReferenceType*)new ArrayType(str) : (const ReferenceType*)new ClassType(str);
+		return str[0] == '[' ? (const ReferenceType*)ArrayType::getInstance(str) : (const ReferenceType*)ClassType::getInstance(str);
 	}
 
 
 	const ReferenceType* parseParameter(const char*& restrict str) {
 		switch(str[0]) {
-			case 'L': return new ClassType(str += 1);
-			case '[': return new ArrayType(str);
+			case 'L': return ClassType::getInstance(str += 1);
+			case '[': return ArrayType::getInstance(str);
 			case 'T': return new ParameterType(str += 1);
 			default:
 				throw InvalidTypeNameException(str);
@@ -59,7 +59,7 @@ namespace jdecompiler {
 
 
 	static inline const ClassType* parseClassType(const char*& restrict str) {
-		return str[0] == 'L' ? new ClassType(str += 1) : throw InvalidSignatureException(str, 0);
+		return str[0] == 'L' ? ClassType::getInstance(str += 1) : throw InvalidSignatureException(str, 0);
 	}
 
 
@@ -26,7 +26,7 @@ namespace jdecompiler {
 				const char* const memberTypeStart = str;
 
 				memberType = parseType(str);
-				elementType = nestingLevel == 1 ? memberType : new ArrayType(memberType, (uint16_t)(nestingLevel - 1));
+				elementType = nestingLevel == 1 ? memberType : getInstance(memberType, (uint16_t)(nestingLevel - 1));
 
 				this->name = memberType->getName() + braces;
 				this->encodedName = string(srcStr, 0, str - memberTypeStart + nestingLevel); // cut string
@@ -51,11 +51,97 @@ namespace jdecompiler {
 				this->encodedName = string(nestingLevel, '[') + memberType->getEncodedName();
 
 				this->memberType = memberType;
-				this->elementType = nestingLevel == 1 ? memberType : new ArrayType(memberType, (uint16_t)(nestingLevel - 1));
+				this->elementType = nestingLevel == 1 ? memberType : getInstance(memberType, (uint16_t)(nestingLevel - 1));
 			}
 
 			ArrayType(const string& memberName, uint16_t nestingLevel): ArrayType(parseType(memberName), nestingLevel) {}
 
+		private:
+			/* Arrays of primitives and of class types without parameters by the encoded name */
+			template<typename F>
+			static const ArrayType* intern(const string& encodedName, const F& creator) {
+				static umap<string, const ArrayType*> instances;
+				static mutex instancesMutex;
+
+				{
+					const lock_guard<mutex> lock(instancesMutex);
+
+					const auto found = instances.find(encodedName);
+					if(found != instances.end())
+						return found->second;
+				}
+
+				/* The element type is interned too, so the array is created without the lock */
+				const ArrayType* instance = creator();
+
+				const lock_guard<mutex> lock(instancesMutex);
+
+				const auto inserted = instances.emplace(encodedName, instance);
+				if(!inserted.second)
+					delete instance;
+
+				return inserted.first->second;
+			}
+
+		public:
+			/* Moves the string to the end of the type like the constructor.
+			   Arrays of type parameters and of class types with parameters are not shared */
+			static const ArrayType* getInstance(const char*& restrict str) {
+				const char* end = str;
+
+				while(*end == '[')
+					++end;
+
+				switch(*end) {
+					case 'B': case 'C': case 'S': case 'I': case 'J': case 'F': case 'D': case 'Z':
+						++end;
+						break;
+
+					case 'L':
+						while(*end != ';' && *end != '\0') {
+							if(*end == '<')
+								return new ArrayType(str);
+							++end;
+						}
+
+						if(*end == ';')
+							++end;
+						break;
+
+					default:
+						return new ArrayType(str);
+				}
+
+				const string encodedName(str, end);
+				str = end;
+
+				return intern(encodedName, [&encodedName] () { return new ArrayType(encodedName); });
+			}
+
+			static inline const ArrayType* getInstance(const char*&& str) {
+				return getInstance(static_cast<const char*&>(str));
+			}
+
+			static const ArrayType* getInstance(const Type* memberType, uint16_t nestingLevel = 1) {
+				const ArrayType* arrayMemberType = dynamic_cast<const ArrayType*>(memberType);
+				const Type* baseType = arrayMemberType != nullptr ? arrayMemberType->memberType : memberType;
+
+				const ClassType* classType = dynamic_cast<const ClassType*>(baseType);
+
+				if(!instanceof<const PrimitiveType*>(baseType) && (classType == nullptr || !classType->parameters.empty()))
+					return new ArrayType(memberType, nestingLevel);
+
+				const string encodedName = string(nestingLevel + (arrayMemberType != nullptr ? arrayMemberType->nestingLevel : 0), '[') +
+						baseType->getEncodedName();
+
+				return intern(encodedName, [memberType, nestingLevel] () { return new ArrayType(memberType, nestingLevel); });
+			}
+
+			static inline const ArrayType* getInstance(const Type& memberType, uint16_t nestingLevel = 1) {
+				return getInstance(&memberType, nestingLevel);
+			}
+
+
 			virtual string toString(const ClassInfo& classinfo) const override {
 				return memberType->toString(classinfo) + braces;
 			}
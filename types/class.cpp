@@ -101,7 +101,7 @@ namespace jdecompiler {
 				} else {
 					isNested = true;
 					isAnonymous = all_of(simpleName.begin(), simpleName.end(), [] (unsigned char c) { return isdigit(c); });
-					enclosingClass = new ClassType(encodedName.substr(0, enclosingClassNameEndPos));
+					enclosingClass = getInstance(encodedName.substr(0, enclosingClassNameEndPos));
 
 					fullSimpleName = enclosingClass->fullSimpleName + (isAnonymous ? '$' : '.') + simpleName;
 
@@ -112,6 +112,60 @@ namespace jdecompiler {
 				}
 			}
 
+		private:
+			/* Class types without parameters by the encoded name. Each type is created once and shared by all classes */
+			static const ClassType* intern(const string& encodedName) {
+				static umap<string, const ClassType*> instances;
+				static mutex instancesMutex;
+
+				{
+					const lock_guard<mutex> lock(instancesMutex);
+
+					const auto found = instances.find(encodedName);
+					if(found != instances.end())
+						return found->second;
+				}
+
+				/* The type is created without the lock, because the enclosing class is interned too */
+				const ClassType* instance = new ClassType(encodedName);
+
+				const lock_guard<mutex> lock(instancesMutex);
+
+				const auto inserted = instances.emplace(encodedName, instance);
+				if(!inserted.second)
+					delete instance;
+
+				return inserted.first->second;
+			}
+
+		public:
+			/* Moves the string to the end of the type like the constructor. Types with parameters are not shared */
+			static const ClassType* getInstance(const char*& restrict str) {
+				const char* end = str;
+
+				while(*end != ';' && *end != '\0') {
+					if(*end == '<')
+						return new ClassType(str);
+					++end;
+				}
+
+				const ClassType* instance = intern(string(str, end));
+				str = *end == ';' ? end + 1 : end;
+				return instance;
+			}
+
+			static inline const ClassType* getInstance(const char*&& str) {
+				return getInstance(static_cast<const char*&>(str));
+			}
+
+			static inline const ClassType* getInstance(const string& str) {
+				return getInstance(str.c_str());
+			}
+
+			static inline const ClassType* getInstance(const ClassConstant* clazz) {
+				return getInstance(clazz->name);
+			}
+
 			virtual string toString(const ClassInfo&) const override;
 
 			virtual string toString() const override {
@@ -137,14 +191,14 @@ namespace jdecompiler {
 
 
 	static const ClassType
-			*const OBJECT(new ClassType("java/lang/Object")),
-			*const STRING(new ClassType("java/lang/String")),
-			*const CLASS(new ClassType("java/lang/Class")),
-			*const ENUM(new ClassType("java/lang/Enum")),
-			*const THROWABLE(new ClassType("java/lang/Throwable")),
-			*const EXCEPTION(new ClassType("java/lang/Exception")),
-			*const METHOD_TYPE(new ClassType("java/lang/invoke/MethodType")),
-			*const METHOD_HANDLE(new ClassType("java/lang/invoke/MethodHandle"));
+			*const OBJECT(ClassType::getInstance("java/lang/Object")),
+			*const STRING(ClassType::getInstance("java/lang/String")),
+			*const CLASS(ClassType::getInstance("java/lang/Class")),
+			*const ENUM(ClassType::getInstance("java/lang/Enum")),
+			*const THROWABLE(ClassType::getInstance("java/lang/Throwable")),
+			*const EXCEPTION(ClassType::getInstance("java/lang/Exception")),
+			*const METHOD_TYPE(ClassType::getInstance("java/lang/invoke/MethodType")),
+			*const METHOD_HANDLE(ClassType::getInstance("java/lang/invoke/MethodHandle"));
 }
 
 #endif
@@ -45,6 +45,10 @@ namespace jdecompiler {
 				return other->isSpecial();
 			}
 
+			virtual bool canMemoizeCasts() const override final {
+				return true;
+			}
+
 			virtual bool isSubtypeOfImpl(const Type* other) const override {
 				return this == other;
 			}
@@ -9,7 +9,7 @@ namespace jdecompiler {
 			const bool includeBoolean, includeChar;
 
 			static const uint8_t INCLUDE_BOOLEAN = 1, INCLUDE_CHAR = 2;
-			static const uint8_t CHAR_CAPACITY = 2;
+			static const uint8_t CHAR_CAPACITY = 2, MAX_CAPACITY = 4;
 
 		private:
 			const PrimitiveType* const highPrimitiveType;
@@ -39,22 +39,27 @@ namespace jdecompiler {
 
 		public:
 			static const VariableCapacityIntegralType* getInstance(uint8_t minCapacity, uint8_t maxCapacity, bool includeBoolean, bool includeChar) {
-				static vector<const VariableCapacityIntegralType*> instances;
+				/* Indexed directly by the capacities and the flags. Instances are created once and never deleted */
+				static atomic<const VariableCapacityIntegralType*> instances[MAX_CAPACITY + 1][MAX_CAPACITY + 1][2][2];
+				static mutex instancesMutex;
 
 				if(minCapacity > maxCapacity)
 					return nullptr;
 
-				for(const VariableCapacityIntegralType* instance : instances) {
-					if(instance->minCapacity == minCapacity && instance->maxCapacity == maxCapacity &&
-						instance->includeBoolean == includeBoolean && instance->includeChar == includeChar) {
+				if(maxCapacity > MAX_CAPACITY)
+					primitiveTypeByCapacity(maxCapacity, includeChar); // Throws an exception
 
-						return instance;
-					}
-				}
+				atomic<const VariableCapacityIntegralType*>& instance = instances[minCapacity][maxCapacity][includeBoolean][includeChar];
+
+				if(const VariableCapacityIntegralType* existingInstance = instance.load())
+					return existingInstance;
+
+				const lock_guard<mutex> lock(instancesMutex);
 
-				const VariableCapacityIntegralType* instance = new VariableCapacityIntegralType(minCapacity, maxCapacity, includeBoolean, includeChar);
-				instances.push_back(instance);
-				return instance;
+				if(instance.load() == nullptr)
+					instance.store(new VariableCapacityIntegralType(minCapacity, maxCapacity, includeBoolean, includeChar));
+
+				return instance.load();
 			}
 
 			static inline const VariableCapacityIntegralType* getInstance(uint8_t minCapacity, uint8_t maxCapacity, uint8_t flags = 0) {
@@ -93,6 +98,10 @@ namespace jdecompiler {
 				return true;
 			}
 
+			virtual bool canMemoizeCasts() const override {
+				return true;
+			}
+
 			virtual bool isSubtypeOfImpl(const Type* other) const override {
 				if(*this == *other || (other == BOOLEAN && includeBoolean) || other == highPrimitiveType)
 					return true;
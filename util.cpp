@@ -3,6 +3,12 @@
 
 #include "util.h"
 
+#ifdef __unix__
+#	include <sys/stat.h>
+#else
+#	include <direct.h>
+#endif
+
 namespace jdecompiler {
 
 	string toLowerCamelCase(const string& str) {
@@ -68,6 +74,32 @@ namespace jdecompiler {
 		return result;
 	}
 
+	void parallelFor(size_t count, uint32_t jobs, const function<void(size_t)>& func) {
+		if(jobs <= 1 || count <= 1) {
+			for(size_t i = 0; i < count; i++)
+				func(i);
+			return;
+		}
+
+		atomic<size_t> nextIndex(0);
+
+		const auto worker = [&nextIndex, count, &func] () {
+			for(size_t i = nextIndex++; i < count; i = nextIndex++)
+				func(i);
+		};
+
+		const size_t threadsCount = min<size_t>(jobs, count);
+
+		vector<thread> threads;
+		threads.reserve(threadsCount);
+
+		for(size_t i = 0; i < threadsCount; i++)
+			threads.emplace_back(worker);
+
+		for(thread& workerThread : threads)
+			workerThread.join();
+	}
+
 	char* str_concat(const char* str1, const char* str2) {
 		const size_t
 				len1 = strlen(str1),
@@ -262,6 +294,19 @@ namespace jdecompiler {
 
 		return true;
 	}
+
+
+	void createParentDirectories(const string& path) {
+		for(size_t pos = path.find_first_of("/\\", 1); pos != string::npos; pos = path.find_first_of("/\\", pos + 1)) {
+			const string directory = path.substr(0, pos);
+
+			#ifdef __unix__
+				mkdir(directory.c_str(), 0777);
+			#else
+				_mkdir(directory.c_str());
+			#endif
+		}
+	}
 }
 
 #endif
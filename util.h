@@ -13,9 +13,12 @@
 #include "jdecompiler-fwd.h"
 #include "index-types.cpp"
 #include "exceptions.cpp"
+#include "arena.cpp"
 #include "util/typenameof.cpp"
 #include "util/class-input-stream.cpp"
+#include "util/zip-archive.cpp"
 #include "util/format-string.cpp"
+#include "util/output-writer.cpp"
 #include "util/file-binary-output-stream.cpp"
 #include "util/type-traits.cpp"
 #include "util/strutil.cpp"
@@ -23,14 +26,35 @@
 #include "util/instanceof.cpp"
 #include "util/safe-cast.cpp"
 
+#define JDECOMPILER_LOG_OFF   0
+#define JDECOMPILER_LOG_ERROR 1
+#define JDECOMPILER_LOG_DEBUG 2
+#define JDECOMPILER_LOG_TRACE 3
+
+/* The maximal log level compiled into the program. Messages of the higher levels are removed at compile time */
+#ifndef JDECOMPILER_LOG_LEVEL
+#	define JDECOMPILER_LOG_LEVEL JDECOMPILER_LOG_TRACE
+#endif
+
 #define LOG_POINT "[ " __FILE__ " ]: "
-#define log(...) logFunc<cout>(LOG_POINT, __VA_ARGS__)
-#define logerr(...) logFunc<cerr>(LOG_POINT, __VA_ARGS__)
-#define logf(pattern, ...) printf(LOG_POINT pattern "\n", __VA_ARGS__)
+
+/* The arguments are not evaluated if the level is disabled at compile time or at runtime */
+#define LOG_AT(level, ...) static_cast<void>(JDECOMPILER_LOG_##level <= JDECOMPILER_LOG_LEVEL &&\
+		JDECOMPILER_LOG_##level <= jdecompiler::logLevel && (jdecompiler::logFunc<cerr>(LOG_POINT, __VA_ARGS__), true))
+
+#define log(...) LOG_AT(DEBUG, __VA_ARGS__)
+#define logtrace(...) LOG_AT(TRACE, __VA_ARGS__)
+#define logerr(...) LOG_AT(ERROR, __VA_ARGS__)
+#define logf(pattern, ...) static_cast<void>(JDECOMPILER_LOG_DEBUG <= JDECOMPILER_LOG_LEVEL &&\
+		JDECOMPILER_LOG_DEBUG <= jdecompiler::logLevel && fprintf(stderr, LOG_POINT pattern "\n", __VA_ARGS__))
 
 namespace jdecompiler {
 
-	static bool isLastSpaceLogged = true;
+	/* The log level chosen by the --log option, off by default */
+	inline int logLevel = JDECOMPILER_LOG_OFF;
+
+	/* Each thread writes its own log lines */
+	inline thread_local bool isLastSpaceLogged = true;
 
 	template<ostream& out, typename Arg1, typename... Args>
 	inline void logFunc(const Arg1& arg1, const Args&... args) {
@@ -95,6 +119,11 @@ namespace jdecompiler {
 
 	extern string repeat(const string&, size_t);
 
+
+	/* Calls func for each index from 0 to count on up to jobs threads.
+	   Indexes are handed out in ascending order, func must catch its own exceptions */
+	extern void parallelFor(size_t count, uint32_t jobs, const function<void(size_t)>& func);
+
 	/* Concatenates two c-strings, allocates new memory that should be freed */
 	extern char* str_concat(const char*, const char*);
 
@@ -251,6 +280,9 @@ namespace jdecompiler {
 	extern bool stringStartsWith(const string&, const string&);
 	extern bool stringEndsWith(const string&, const string&);
 
+	/* Creates all missing directories of the path, except the last component */
+	extern void createParentDirectories(const string& path);
+
 	template<typename T>
 	static inline enable_if_t<is_integral_v<T>, bool> isPowerOfTwo(T x) {
 		return (x & (x - 1)) == 0;
@@ -1,96 +1,203 @@
 #ifndef JDECOMPILER_CLASS_BINARY_INPUT_STREAM_CPP
 #define JDECOMPILER_CLASS_BINARY_INPUT_STREAM_CPP
 
-#include "file-binary-input-stream.cpp"
+#include <cstring>
+#include <fstream>
+#include "ioexceptions.cpp"
+
+#ifdef __unix__
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
 
 namespace jdecompiler {
 
 	using namespace util;
 
-	struct ClassInputStream final: BinaryInputStream {
+	/* Reads a class file mapped into the memory. All values are read directly from the mapped data,
+	   readBytes and readString return views into it, so they must not be deleted.
+	   The data is kept alive while the stream exists */
+	struct ClassInputStream final {
 
 		private:
-			BinaryInputStream& instream;
+			const uint8_t* data;
+			size_t size;
+			size_t pos = 0;
+			bool mapped = false;
+
+			/* One bounds check for the whole value instead of a check per byte */
+			inline const uint8_t* take(size_t count) {
+				if(count > size - pos)
+					throw EOFException();
+
+				const uint8_t* ptr = data + pos;
+				pos += count;
+				return ptr;
+			}
+
+			template<typename T>
+			inline T readBigEndian() {
+				const uint8_t* ptr = take(sizeof(T));
+
+				T value = 0;
+				for(size_t i = 0; i < sizeof(T); i++)
+					value = static_cast<T>(value << 8 | ptr[i]);
+
+				return value;
+			}
 
 		public:
 			const string fileName;
 
-			explicit ClassInputStream(BinaryInputStream& instream, const string& fileName):
-					instream(instream), fileName(fileName) {}
+			explicit ClassInputStream(const string& fileName): fileName(fileName) {
+				#ifdef __unix__
+					const int fd = open(fileName.c_str(), O_RDONLY);
 
-			explicit ClassInputStream(FileBinaryInputStream& instream):
-					ClassInputStream(instream, instream.path) {}
+					if(fd == -1)
+						throw FileNotFoundException(fileName + ": " + strerror(errno));
 
-			inline virtual const streampos& getPos() const override {
-				return instream.getPos();
-			}
+					struct stat fileStat;
+
+					if(fstat(fd, &fileStat) == -1) {
+						const int errorCode = errno;
+						::close(fd);
+						throw IOException(fileName + ": " + strerror(errorCode));
+					}
+
+					size = static_cast<size_t>(fileStat.st_size);
+
+					if(size == 0) {
+						data = nullptr;
+					} else {
+						void* mappedData = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+						if(mappedData == MAP_FAILED) {
+							const int errorCode = errno;
+							::close(fd);
+							throw IOException(fileName + ": " + strerror(errorCode));
+						}
+
+						data = static_cast<const uint8_t*>(mappedData);
+						mapped = true;
+					}
+
+					::close(fd);
 
-			inline virtual void setPosTo(const streampos& pos) {
-				instream.setPosTo(pos);
+				#else
+					ifstream file(fileName, std::ios::binary | std::ios::ate);
+
+					if(!file.is_open())
+						throw FileNotFoundException(fileName);
+
+					size = static_cast<size_t>(file.tellg());
+					uint8_t* buffer = new uint8_t[size];
+
+					file.seekg(0);
+					file.read(reinterpret_cast<char*>(buffer), size);
+
+					data = buffer;
+				#endif
 			}
 
-			inline virtual size_t available() const override {
-				return instream.available();
+			/* Takes ownership of the buffer allocated with new[] */
+			ClassInputStream(const uint8_t* data, size_t size, const string& fileName):
+					data(data), size(size), fileName(fileName) {}
+
+			ClassInputStream(const ClassInputStream&) = delete;
+			ClassInputStream& operator=(const ClassInputStream&) = delete;
+
+
+			inline size_t getPos() const {
+				return pos;
 			}
 
-			inline virtual int8_t readByte() override {
-				return instream.readByte();
+			inline void setPos(size_t newPos) {
+				if(newPos > size)
+					throw EOFException();
+
+				pos = newPos;
 			}
 
-			inline virtual uint8_t readUByte() override {
-				return instream.readUByte();
+			inline void skip(size_t count) {
+				take(count);
 			}
 
-			inline virtual int16_t readShort() override {
-				return instream.readShort();
+			inline size_t available() const {
+				return size - pos;
 			}
 
-			inline virtual uint16_t readUShort() override {
-				return instream.readUShort();
+			inline int8_t readByte() {
+				return static_cast<int8_t>(*take(1));
 			}
 
-			inline virtual int32_t readInt() override {
-				return instream.readInt();
+			inline uint8_t readUByte() {
+				return *take(1);
 			}
 
-			inline virtual uint32_t readUInt() override {
-				return instream.readUInt();
+			inline int16_t readShort() {
+				return static_cast<int16_t>(readBigEndian<uint16_t>());
 			}
 
-			inline virtual int64_t readLong() override {
-				return instream.readLong();
+			inline uint16_t readUShort() {
+				return readBigEndian<uint16_t>();
 			}
 
-			inline virtual uint64_t readULong() override {
-				return instream.readULong();
+			inline int32_t readInt() {
+				return static_cast<int32_t>(readBigEndian<uint32_t>());
 			}
 
+			inline uint32_t readUInt() {
+				return readBigEndian<uint32_t>();
+			}
 
-			inline virtual float readFloat() override {
-				return instream.readFloat();
+			inline int64_t readLong() {
+				return static_cast<int64_t>(readBigEndian<uint64_t>());
 			}
 
-			inline virtual double readDouble() override {
-				return instream.readDouble();
+			inline uint64_t readULong() {
+				return readBigEndian<uint64_t>();
 			}
 
 
-			inline virtual const uint8_t* readBytes(uint32_t size) override {
-				return instream.readBytes(size);
+			inline float readFloat() {
+				static_assert(sizeof(float) == sizeof(uint32_t));
+
+				const uint32_t bits = readBigEndian<uint32_t>();
+				float value;
+				memcpy(&value, &bits, sizeof(float));
+				return value;
 			}
 
-			inline virtual const char* readString(uint32_t size) override {
-				return instream.readString(size);
+			inline double readDouble() {
+				static_assert(sizeof(double) == sizeof(uint64_t));
+
+				const uint64_t bits = readBigEndian<uint64_t>();
+				double value;
+				memcpy(&value, &bits, sizeof(double));
+				return value;
 			}
 
 
-			inline virtual void close() override {
-				instream.close();
+			inline const uint8_t* readBytes(uint32_t count) {
+				return take(count);
 			}
 
+			inline const char* readString(uint32_t count) {
+				return reinterpret_cast<const char*>(take(count));
+			}
+
+
+			~ClassInputStream() {
+				#ifdef __unix__
+					if(mapped) {
+						munmap(const_cast<uint8_t*>(data), size);
+						return;
+					}
+				#endif
 
-			inline virtual ~ClassInputStream() {
-				delete &instream;
+				delete[] data;
 			}
 	};
 }
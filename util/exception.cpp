@@ -1 +0,0 @@
-/home/winch/0x590/c++/util/exception.cpp
\ No newline at end of file
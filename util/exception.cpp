@@ -0,0 +1,78 @@
+#ifndef UTIL_EXCEPTION_CPP
+#define UTIL_EXCEPTION_CPP
+
+#include <exception>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdlib>
+#include <execinfo.h>
+
+namespace util {
+
+	using std::string;
+	using std::exception;
+
+	/* Most exceptions are caught and never printed, so the backtrace is captured only if captureBacktraces is set,
+	   and its symbols are resolved only when it is printed */
+	struct Exception: exception {
+		public:
+			static const int BACKTRACE_BUFFER_SIZE = 128;
+
+			static inline bool captureBacktraces = false;
+
+		protected:
+			const string message;
+			std::vector<void*> backtraceBuffer;
+
+		public:
+			Exception(const string& message): message(message) {
+				if(captureBacktraces) {
+					backtraceBuffer.resize(BACKTRACE_BUFFER_SIZE);
+					backtraceBuffer.resize(static_cast<size_t>(backtrace(backtraceBuffer.data(), BACKTRACE_BUFFER_SIZE)));
+				}
+			}
+
+			Exception(const char* message): Exception((string)message) {}
+			Exception(): Exception(string()) {}
+
+			virtual const char* what() const noexcept override {
+				return message.c_str();
+			}
+
+			virtual string toString() const {
+				return message;
+			}
+
+			inline const string& getMessage() const {
+				return message;
+			}
+
+			inline bool hasBacktrace() const noexcept {
+				return !backtraceBuffer.empty();
+			}
+
+			void printBacktrace(std::ostream& out) const {
+				if(backtraceBuffer.empty())
+					return;
+
+				const int backtraceLength = static_cast<int>(backtraceBuffer.size());
+				char** backtraceSymbols = backtrace_symbols(backtraceBuffer.data(), backtraceLength);
+
+				for(int i = 0; i < backtraceLength; ++i) {
+					out << '[' << (i < 10 ? " " : "") << i << "]: ";
+
+					if(backtraceSymbols != nullptr)
+						out << backtraceSymbols[i] << '\n';
+					else
+						out << backtraceBuffer[i] << '\n';
+				}
+
+				free(backtraceSymbols);
+			}
+
+			virtual ~Exception() {}
+	};
+}
+
+#endif
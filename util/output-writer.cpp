@@ -0,0 +1,67 @@
+#ifndef JDECOMPILER_OUTPUT_WRITER_CPP
+#define JDECOMPILER_OUTPUT_WRITER_CPP
+
+#include <string>
+
+namespace jdecompiler {
+
+	using std::string;
+
+	/* Append-only buffer for the source code. Scopes, methods and classes write into one buffer
+	   instead of returning strings, so the nested code is not copied at every level of nesting */
+	struct OutputWriter final {
+		private:
+			string buffer;
+
+		public:
+			OutputWriter() noexcept {}
+
+			OutputWriter(const OutputWriter&) = delete;
+			OutputWriter& operator=(const OutputWriter&) = delete;
+
+
+			inline OutputWriter& operator<<(const string& str) {
+				buffer += str;
+				return *this;
+			}
+
+			inline OutputWriter& operator<<(const char* str) {
+				buffer += str;
+				return *this;
+			}
+
+			inline OutputWriter& operator<<(char c) {
+				buffer += c;
+				return *this;
+			}
+
+
+			inline size_t size() const {
+				return buffer.size();
+			}
+
+			inline bool empty() const {
+				return buffer.empty();
+			}
+
+			inline char& back() {
+				return buffer.back();
+			}
+
+			/* Used only for the text which is known after the text following it, such as imports */
+			inline void insert(size_t pos, const string& str) {
+				buffer.insert(pos, str);
+			}
+
+			inline const string& str() const {
+				return buffer;
+			}
+
+			/* Moves the text out of the writer */
+			inline string release() {
+				return std::move(buffer);
+			}
+	};
+}
+
+#endif
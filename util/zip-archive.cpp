@@ -0,0 +1,198 @@
+#ifndef JDECOMPILER_ZIP_ARCHIVE_CPP
+#define JDECOMPILER_ZIP_ARCHIVE_CPP
+
+#include <zlib.h>
+#include "class-input-stream.cpp"
+
+namespace jdecompiler {
+
+	using namespace util;
+
+	struct ZipFormatException: IOException {
+		ZipFormatException(const string& message): IOException(message) {}
+	};
+
+	/* Reads the central directory of a zip archive (jar, war) mapped into the memory.
+	   Entries are inflated on demand, each one independently, so it can be done in several threads */
+	struct ZipArchive {
+		public:
+			struct Entry {
+				const string name;
+				const uint16_t compressionMethod;
+				const uint32_t crc, compressedSize, uncompressedSize, localHeaderOffset;
+
+				Entry(const string& name, uint16_t compressionMethod, uint32_t crc, uint32_t compressedSize, uint32_t uncompressedSize, uint32_t localHeaderOffset):
+						name(name), compressionMethod(compressionMethod), crc(crc), compressedSize(compressedSize),
+						uncompressedSize(uncompressedSize), localHeaderOffset(localHeaderOffset) {}
+
+				/* Returns false if the name can lead outside of the directory it is appended to: the name is absolute,
+				   starts with a drive letter, contains backslashes or zero chars or has a ".." component */
+				bool hasSafeName() const {
+					if(name.empty() || name[0] == '/' || name.find_first_of(string("\\:\0", 3)) != string::npos)
+						return false;
+
+					for(size_t start = 0, end; start <= name.size(); start = end + 1) {
+						end = name.find('/', start);
+
+						if(end == string::npos)
+							end = name.size();
+
+						if(name.compare(start, end - start, "..") == 0)
+							return false;
+					}
+
+					return true;
+				}
+			};
+
+		private:
+			static constexpr uint32_t
+					LOCAL_HEADER_SIGNATURE = 0x04034B50,
+					CENTRAL_HEADER_SIGNATURE = 0x02014B50,
+					END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06054B50;
+
+			static constexpr uint32_t LOCAL_HEADER_SIZE = 30, CENTRAL_HEADER_SIZE = 46, END_OF_CENTRAL_DIRECTORY_SIZE = 22;
+
+			static constexpr uint16_t STORED = 0, DEFLATED = 8;
+
+			ClassInputStream instream;
+			const uint8_t* const data;
+			const size_t size;
+
+			vector<Entry> entries;
+
+			static inline uint16_t readUShort(const uint8_t* ptr) {
+				return static_cast<uint16_t>(ptr[0] | ptr[1] << 8);
+			}
+
+			static inline uint32_t readUInt(const uint8_t* ptr) {
+				return static_cast<uint32_t>(ptr[0] | ptr[1] << 8 | ptr[2] << 16) | static_cast<uint32_t>(ptr[3]) << 24;
+			}
+
+			inline void checkBounds(size_t offset, size_t count) const {
+				if(offset > size || count > size - offset)
+					throw ZipFormatException(path + ": unexpected end of archive");
+			}
+
+			size_t findEndOfCentralDirectory() const {
+				if(size < END_OF_CENTRAL_DIRECTORY_SIZE)
+					throw ZipFormatException(path + ": file is too short to be a zip archive");
+
+				/* The end of central directory record can be followed by a comment up to 65535 bytes long */
+				const size_t minOffset = size > END_OF_CENTRAL_DIRECTORY_SIZE + UINT16_MAX ? size - END_OF_CENTRAL_DIRECTORY_SIZE - UINT16_MAX : 0;
+
+				for(size_t offset = size - END_OF_CENTRAL_DIRECTORY_SIZE + 1; offset-- > minOffset; ) {
+					if(readUInt(data + offset) == END_OF_CENTRAL_DIRECTORY_SIGNATURE)
+						return offset;
+				}
+
+				throw ZipFormatException(path + ": end of central directory not found");
+			}
+
+		public:
+			const string path;
+
+			explicit ZipArchive(const string& path): instream(path), data(instream.readBytes(instream.available())), size(instream.getPos()), path(path) {
+				const uint8_t* const endRecord = data + findEndOfCentralDirectory();
+
+				const uint16_t entryCount = readUShort(endRecord + 10);
+				const uint32_t centralDirectoryOffset = readUInt(endRecord + 16);
+
+				if(entryCount == UINT16_MAX || centralDirectoryOffset == UINT32_MAX)
+					throw ZipFormatException(path + ": zip64 archives are not supported");
+
+				entries.reserve(entryCount);
+
+				size_t offset = centralDirectoryOffset;
+
+				for(uint16_t i = 0; i < entryCount; i++) {
+					checkBounds(offset, CENTRAL_HEADER_SIZE);
+					const uint8_t* const header = data + offset;
+
+					if(readUInt(header) != CENTRAL_HEADER_SIGNATURE)
+						throw ZipFormatException(path + ": invalid central directory entry #" + to_string(i));
+
+					const uint16_t nameLength = readUShort(header + 28),
+					               extraLength = readUShort(header + 30),
+					               commentLength = readUShort(header + 32);
+
+					checkBounds(offset, CENTRAL_HEADER_SIZE + nameLength);
+
+					entries.emplace_back(string(reinterpret_cast<const char*>(header + CENTRAL_HEADER_SIZE), nameLength),
+							readUShort(header + 10), readUInt(header + 16), readUInt(header + 20), readUInt(header + 24), readUInt(header + 42));
+
+					offset += CENTRAL_HEADER_SIZE + nameLength + extraLength + commentLength;
+				}
+			}
+
+			ZipArchive(const ZipArchive&) = delete;
+			ZipArchive& operator=(const ZipArchive&) = delete;
+
+			inline const vector<Entry>& getEntries() const {
+				return entries;
+			}
+
+			/* Returns the stream which owns the uncompressed data of the entry. Thread safe */
+			ClassInputStream* open(const Entry& entry, const string& fileName) const {
+				checkBounds(entry.localHeaderOffset, LOCAL_HEADER_SIZE);
+				const uint8_t* const header = data + entry.localHeaderOffset;
+
+				if(readUInt(header) != LOCAL_HEADER_SIGNATURE)
+					throw ZipFormatException(path + ": invalid local header of entry " + entry.name);
+
+				const size_t dataOffset = entry.localHeaderOffset + LOCAL_HEADER_SIZE + readUShort(header + 26) + readUShort(header + 28);
+				checkBounds(dataOffset, entry.compressedSize);
+
+				const uint8_t* const compressedData = data + dataOffset;
+				uint8_t* const buffer = new uint8_t[entry.uncompressedSize];
+
+				switch(entry.compressionMethod) {
+					case STORED:
+						if(entry.compressedSize != entry.uncompressedSize) {
+							delete[] buffer;
+							throw ZipFormatException(path + ": sizes of stored entry " + entry.name + " do not match");
+						}
+
+						memcpy(buffer, compressedData, entry.uncompressedSize);
+						break;
+
+					case DEFLATED: {
+						z_stream zstream {};
+						zstream.next_in = const_cast<Bytef*>(compressedData);
+						zstream.avail_in = entry.compressedSize;
+						zstream.next_out = buffer;
+						zstream.avail_out = entry.uncompressedSize;
+
+						/* Negative window bits mean raw deflate data without zlib header */
+						int status = inflateInit2(&zstream, -MAX_WBITS);
+
+						if(status == Z_OK) {
+							status = inflate(&zstream, Z_FINISH);
+							inflateEnd(&zstream);
+						}
+
+						if(status != Z_STREAM_END || zstream.total_out != entry.uncompressedSize) {
+							delete[] buffer;
+							throw ZipFormatException(path + ": cannot inflate entry " + entry.name);
+						}
+
+						break;
+					}
+
+					default:
+						delete[] buffer;
+						throw ZipFormatException(path + ": unsupported compression method " + to_string(entry.compressionMethod) +
+								" of entry " + entry.name);
+				}
+
+				if(crc32(crc32(0, Z_NULL, 0), buffer, entry.uncompressedSize) != entry.crc) {
+					delete[] buffer;
+					throw ZipFormatException(path + ": checksum mismatch of entry " + entry.name);
+				}
+
+				return new ClassInputStream(buffer, entry.uncompressedSize, fileName);
+			}
+	};
+}
+
+#endif
@@ -55,7 +55,7 @@ namespace jdecompiler {
 	Variable::Variable(const Type* type, bool declared, bool isFixedType): type(type), declared(declared), isFixedType(isFixedType) {}
 
 
-	template<bool widest = true>
+	template<bool widest>
 	const Type* Variable::setType(const Type* newType) const {
 		if(isFixedType) {
 			if(type->isSubtypeOf(newType))
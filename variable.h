@@ -3,7 +3,7 @@
 
 namespace jdecompiler {
 
-	struct Variable {
+	struct Variable: ArenaObject {
 		protected:
 			static string getRawNameByType(const Type*, bool* unchecked);
 